@@ -0,0 +1,61 @@
+#include <locale.h>
+
+#include "JSONColumnar.h"
+
+static const char* s_Rows = "[{\"id\": 1, \"price\": 9.5, \"name\": \"apple\", \"stock\": true, \"meta\": {\"tags\": [1, 2]}},\n"
+                            " {\"id\": 2, \"name\": \"pear\", \"stock\": false},\n"
+                            " {\"id\": -3, \"price\": \"n/a\", \"name\": null, \"stock\": true}]";
+
+int main(void)
+{
+    setlocale(LC_ALL, "");
+
+    JSONColumnSpecT spec[] = {{(const int8_t*) "id", JSON_COLUMN_TYPE_U32},
+                              {(const int8_t*) "price", JSON_COLUMN_TYPE_DOUBLE},
+                              {(const int8_t*) "name", JSON_COLUMN_TYPE_STRING},
+                              {(const int8_t*) "stock", JSON_COLUMN_TYPE_BOOL}};
+    size_t expectedNulls[] = {1, 2, 1, 0};
+    size_t columnCount = sizeof(spec) / sizeof(spec[0]);
+    int status = 0;
+
+    JSONColumnarTableT table;
+    JSONParserResultT parseResult =
+            json_columnar_parse_buffer((const int8_t*) s_Rows, strlen(s_Rows), spec, columnCount, &table);
+    if (JSON_PARSE_RESULT_OK != parseResult || 3 != table.rowCount)
+    {
+        LOG_ERROR("Error while extracting columns!\n");
+        status = -1;
+    }
+    for (size_t c = 0; c < table.columnCount; c++)
+    {
+        JSONColumnT* column = &table.columns[c];
+        printf("%.*s: %zu nulls\n", (int) column->key.length, (const char*) column->key.data, column->nullCount);
+        if (expectedNulls[c] != column->nullCount) { status = -1; }
+    }
+    json_columnar_destroy(&table);
+
+    // The buffer is read up to length only, cutting off the closing bracket has to be reported
+    parseResult = json_columnar_parse_buffer((const int8_t*) s_Rows, strlen(s_Rows) - 1, spec, columnCount, &table);
+    if (JSON_PARSE_RESULT_ERROR != parseResult)
+    {
+        LOG_ERROR("Truncated input was accepted!\n");
+        status = -1;
+    }
+    json_columnar_destroy(&table);
+
+    // Numbers follow the JSON grammar and skipped members accept only the true, false and null literals
+    const char* malformed[] = {"[{\"id\": -}]", "[{\"id\": --5}]", "[{\"id\": 1e}]", "[{\"id\": 1.2.3}]",
+                               "[{\"other\": nope}]"};
+    for (size_t m = 0; m < sizeof(malformed) / sizeof(malformed[0]); m++)
+    {
+        parseResult = json_columnar_parse_buffer((const int8_t*) malformed[m], strlen(malformed[m]), spec,
+                                                 columnCount, &table);
+        if (JSON_PARSE_RESULT_ERROR != parseResult)
+        {
+            LOG_ERROR("Malformed input %s was accepted!\n", malformed[m]);
+            status = -1;
+        }
+    }
+
+    return status;
+}
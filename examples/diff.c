@@ -0,0 +1,80 @@
+#include <locale.h>
+
+#include "JSONHash.h"
+
+static JSONObjectT* parse_text(JSONParserT* parser, const char* text)
+{
+    size_t length = strlen(text);
+    int8_t* buffer = (int8_t*) CMALLOC(length + 1);
+    CMEMCPY(buffer, text, length + 1);
+
+    parser->buffer = buffer;
+    parser->length = length;
+    parser->offset = 0;
+    parser->mark = JSON_STREAM_NO_MARK;
+    parser->root = json_parse_value(parser);
+    return parser->root;
+}
+
+static void print_difference(JSONObjectT* left, JSONObjectT* right, void* context)
+{
+    JSONObjectT* node = (NULL != left) ? left : right;
+    (*(size_t*) context)++;
+
+    if (json_is_node_object_element(node))
+    {
+        const char* change = (NULL == left) ? "added" : (NULL == right) ? "removed" : "changed";
+        printf("%s %s\n", ((JSONObjectObjectElementT*) node)->key->value->data, change);
+    }
+    else { printf("array element %s\n", (NULL == left) ? "added" : (NULL == right) ? "removed" : "changed"); }
+}
+
+int main(void)
+{
+    setlocale(LC_ALL, "");
+    int status = 0;
+
+    JSONParserT original = {NULL};
+    JSONParserT reordered = {NULL};
+    JSONParserT changed = {NULL};
+    JSONObjectT* left = parse_text(&original, "{\"name\": \"a\", \"tags\": [1, 2], \"size\": {\"w\": 1, \"h\": 2}}");
+    JSONObjectT* same = parse_text(&reordered, "{\"size\": {\"h\": 2, \"w\": 1}, \"tags\": [1, 2], \"name\": \"a\"}");
+    JSONObjectT* right =
+            parse_text(&changed, "{\"name\": \"a\", \"tags\": [1, 2, 3], \"size\": {\"w\": 4}, \"id\": 7}");
+
+    // Member order does not matter, so the reordered document is equal and hashes the same
+    if (!json_equals(left, same) || json_hash(left) != json_hash(same)) { status = -1; }
+    if (json_equals(left, right)) { status = -1; }
+
+    size_t differences = 0;
+    json_diff(left, right, print_difference, &differences);
+    if (4 != differences) { status = -1; }
+
+    // Repeated keys pair by occurrence, the second "a" is compared with the second "a"
+    const char* repeatedText = "{\"a\": 1, \"b\": 0, \"a\": 2, \"c\": 0, \"d\": 0,"
+                               " \"e\": 0, \"f\": 0, \"g\": 0, \"a\": 3}";
+    JSONParserT repeated = {NULL};
+    JSONParserT repeatedAgain = {NULL};
+    JSONParserT pair = {NULL};
+    JSONParserT pairChanged = {NULL};
+    JSONObjectT* first = parse_text(&repeated, repeatedText);
+    JSONObjectT* second = parse_text(&repeatedAgain, repeatedText);
+    JSONObjectT* pairLeft = parse_text(&pair, "{\"a\": 1, \"a\": 2}");
+    JSONObjectT* pairRight = parse_text(&pairChanged, "{\"a\": 1, \"a\": 5}");
+    if (!json_equals(first, second) || json_equals(pairLeft, pairRight)) { status = -1; }
+
+    differences = 0;
+    json_diff(first, second, print_difference, &differences);
+    json_diff(pairLeft, pairRight, print_difference, &differences);
+    if (1 != differences) { status = -1; }
+
+    destroy_json_parser(&pairChanged);
+    destroy_json_parser(&pair);
+    destroy_json_parser(&repeatedAgain);
+    destroy_json_parser(&repeated);
+    destroy_json_parser(&changed);
+    destroy_json_parser(&reordered);
+    destroy_json_parser(&original);
+
+    return status;
+}
@@ -0,0 +1,107 @@
+#include <locale.h>
+
+#include "JSONHash.h"
+
+#define EXAMPLE_ROW_COUNT 20000u
+
+static BOOL write_files(const char* plainPath, const char* gzipPath)
+{
+    FILE* plain = fopen(plainPath, "wb");
+    gzFile compressed = gzopen(gzipPath, "wb");
+    BOOL result = (NULL != plain && NULL != compressed);
+
+    for (uint32_t row = 0; row < EXAMPLE_ROW_COUNT && result; row++)
+    {
+        char line[128];
+        int length = snprintf(line, sizeof(line), "%s{\"id\": %u, \"name\": \"row%u\", \"even\": %s}",
+                              (0 == row) ? "[" : ",\n", row, row, (0 == row % 2u) ? "true" : "false");
+        result = (fwrite(line, 1, (size_t) length, plain) == (size_t) length) &&
+                 (gzwrite(compressed, line, (unsigned) length) == length);
+    }
+    if (result) { result = (fwrite("]", 1, 1, plain) == 1) && (gzwrite(compressed, "]", 1) == 1); }
+
+    if (NULL != plain) { fclose(plain); }
+    if (NULL != compressed) { gzclose(compressed); }
+    return result;
+}
+
+static BOOL write_damaged_copy(const char* sourcePath, const char* path, BOOL truncate)
+{
+    int8_t data[1024 * 1024];
+    FILE* source = fopen(sourcePath, "rb");
+    size_t size = (NULL != source) ? fread(data, 1, sizeof(data), source) : 0;
+    BOOL result = (size > 64u && size < sizeof(data));
+    if (NULL != source) { fclose(source); }
+
+    if (result)
+    {
+        // Either cut off the trailer and the end of the deflate data, or overwrite bytes in the middle
+        if (truncate) { size -= 12u; }
+        else { CMEMSET(&data[size / 2u], 0xFF, 16u); }
+
+        FILE* file = fopen(path, "wb");
+        result = (NULL != file) && (fwrite(data, 1, size, file) == size);
+        if (NULL != file) { fclose(file); }
+    }
+    return result;
+}
+
+static BOOL check_damaged_file(const char* path)
+{
+    JSONParserT parser = {NULL};
+    BOOL result = (JSON_PARSE_RESULT_ERROR == json_parse_file(path, &parser));
+    if (!result) { LOG_ERROR("%s was parsed without an error!\n", path); }
+    destroy_json_parser(&parser);
+    return result;
+}
+
+int main(void)
+{
+    setlocale(LC_ALL, "");
+    const char* plainPath = "gzip_example.json";
+    const char* gzipPath = "gzip_example.json.gz";
+    const char* truncatedPath = "gzip_example_truncated.json.gz";
+    const char* corruptPath = "gzip_example_corrupt.json.gz";
+    int status = -1;
+
+    if (!write_files(plainPath, gzipPath)) { LOG_ERROR("Can not write the example files!\n"); }
+    else
+    {
+        JSONParserT plain = {NULL};
+        JSONParserT compressed = {NULL};
+
+        // json_parse_file detects the gzip header and inflates on a second thread while parsing
+        if (JSON_PARSE_RESULT_OK != json_parse_file(plainPath, &plain) ||
+            JSON_PARSE_RESULT_OK != json_parse_file(gzipPath, &compressed))
+        {
+            LOG_ERROR("Error while parsing the example files!\n");
+        }
+        else if (!json_equals(plain.root, compressed.root)) { LOG_ERROR("Documents differ!\n"); }
+        else
+        {
+            printf("%u rows, plain and gzip documents are equal\n", EXAMPLE_ROW_COUNT);
+            status = 0;
+        }
+
+        destroy_json_parser(&compressed);
+        destroy_json_parser(&plain);
+    }
+
+    if (0 == status)
+    {
+        // Damaged archives have to fail instead of leaving the parser waiting for input that never comes
+        if (!write_damaged_copy(gzipPath, truncatedPath, TRUE) || !write_damaged_copy(gzipPath, corruptPath, FALSE))
+        {
+            LOG_ERROR("Can not write the damaged example files!\n");
+            status = -1;
+        }
+        else if (!check_damaged_file(truncatedPath) || !check_damaged_file(corruptPath)) { status = -1; }
+        else { printf("truncated and corrupt archives are reported as errors\n"); }
+    }
+
+    remove(plainPath);
+    remove(gzipPath);
+    remove(truncatedPath);
+    remove(corruptPath);
+    return status;
+}
@@ -0,0 +1,33 @@
+#include <cstdio>
+
+#include "JSONStatic.hpp"
+
+static constexpr auto config = json_parse_static<R"({
+    "name": "server",
+    "port": 8080,
+    "limits": {"connections": 512, "timeout": 2.5},
+    "hosts": ["alpha", "beta"],
+    "constants": {"pi": 3.14159265358979323846, "epsilon": 1e-30}
+})">();
+
+static_assert(json_object_get(config.Root(), "port").Number() == 8080);
+static_assert(json_object_get(config.Root(), "hosts").Size() == 2);
+// Numbers outside the exact fast path are still rounded the way the compiler rounds the same literal
+static_assert(config.Root().Get("constants").Get("pi").Number() == 3.14159265358979323846);
+static_assert(config.Root().Get("constants").Get("epsilon").Number() == 1e-30);
+
+int main(void)
+{
+    JSONStaticValue limits = json_object_get(config.Root(), "limits");
+    JSONStaticValue hosts = json_object_get(config.Root(), "hosts");
+
+    printf("%.*s:%g\n", (int) config.Root().Get("name").String().size(), config.Root().Get("name").String().data(),
+           config.Root().Get("port").Number());
+    printf("connections %g, timeout %g\n", limits.Get("connections").Number(), limits.Get("timeout").Number());
+    for (size_t i = 0; i < hosts.Size(); i++)
+    {
+        printf("host %.*s\n", (int) hosts.At(i).String().size(), hosts.At(i).String().data());
+    }
+
+    return 0;
+}
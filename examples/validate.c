@@ -0,0 +1,56 @@
+#include <locale.h>
+
+#include "JSONValidate.h"
+
+/**
+ * @brief A document and the first error json_validate has to report, JSON_VALIDATE_ERROR_NONE for valid ones
+ */
+typedef struct {
+    const char* text;
+    JSONValidateErrorT errorKind;
+    size_t errorOffset;
+} FixtureT;
+
+static const FixtureT s_Fixtures[] = {
+        {"{\"a\": [1, 2.5e-3, -0, true, false, null], \"b\": {\"c\": \"\\u00e9\\n\"}}", JSON_VALIDATE_ERROR_NONE, 0},
+        {"  [\"\xc3\xa9\", {}, []]  ", JSON_VALIDATE_ERROR_NONE, 0},
+        {"{\"a\": 1,}", JSON_VALIDATE_ERROR_EXPECTED_KEY, 8},
+        {"[1 2]", JSON_VALIDATE_ERROR_EXPECTED_COMMA, 3},
+        {"[01]", JSON_VALIDATE_ERROR_INVALID_NUMBER, 2},
+        {"{\"a\" 1}", JSON_VALIDATE_ERROR_EXPECTED_COLON, 5},
+        {"[\"\\x\"]", JSON_VALIDATE_ERROR_INVALID_ESCAPE, 2},
+        {"[tru]", JSON_VALIDATE_ERROR_INVALID_LITERAL, 1},
+        {"[\"\xc3\"]", JSON_VALIDATE_ERROR_INVALID_UTF8, 2},
+        {"[1] 2", JSON_VALIDATE_ERROR_TRAILING_CHARACTERS, 4},
+        {"{\"a\": [1, 2", JSON_VALIDATE_ERROR_UNEXPECTED_END, 11},
+};
+
+int main(void)
+{
+    setlocale(LC_ALL, "");
+    int status = 0;
+
+    for (size_t i = 0; i < sizeof(s_Fixtures) / sizeof(s_Fixtures[0]); i++)
+    {
+        const FixtureT* fixture = &s_Fixtures[i];
+        size_t errorOffset = 0;
+        JSONValidateErrorT errorKind = JSON_VALIDATE_ERROR_NONE;
+
+        JSONParserResultT result =
+                json_validate((const int8_t*) fixture->text, strlen(fixture->text), &errorOffset, &errorKind);
+        BOOL expectedValid = (JSON_VALIDATE_ERROR_NONE == fixture->errorKind);
+        BOOL matches = (JSON_PARSE_RESULT_OK == result) == expectedValid && errorKind == fixture->errorKind &&
+                       (expectedValid || errorOffset == fixture->errorOffset);
+
+        if (JSON_PARSE_RESULT_OK == result) { printf("valid   %s\n", fixture->text); }
+        else { printf("invalid %s (error %d at offset %zu)\n", fixture->text, errorKind, errorOffset); }
+
+        if (!matches)
+        {
+            LOG_ERROR("Expected error %d at offset %zu!\n", fixture->errorKind, fixture->errorOffset);
+            status = -1;
+        }
+    }
+
+    return status;
+}
@@ -0,0 +1,614 @@
+#ifndef JSONCOLUMNAR_HEADER
+#define JSONCOLUMNAR_HEADER
+/**
+ * @file
+ * @author Krusto Stoyanov ( k.stoianov2@gmail.com )
+ * @brief
+ * @version 1.0
+ * @date
+ *
+ * @section LICENSE
+ * MIT License
+ *
+ * Copyright (c) 2024 Krusto
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Struct-of-arrays extraction from arrays of homogeneous JSON objects.
+ * Every requested key becomes a dense typed column plus a null bitmap,
+ * rows where the key is missing or has a different type are marked null.
+ */
+
+
+/***********************************************************************************************************************
+Includes
+***********************************************************************************************************************/
+#include "JSONParser.h"
+
+/***********************************************************************************************************************
+Macros
+***********************************************************************************************************************/
+#define json_columnar_peek(parser) (((parser)->offset < (parser)->length) ? (parser)->buffer[(parser)->offset] : '\0')
+
+/***********************************************************************************************************************
+Type Definitions
+***********************************************************************************************************************/
+typedef enum
+{
+    JSON_COLUMN_TYPE_U32 = 0,
+    JSON_COLUMN_TYPE_I32,
+    JSON_COLUMN_TYPE_DOUBLE,
+    JSON_COLUMN_TYPE_BOOL,
+    JSON_COLUMN_TYPE_STRING,
+} JSONColumnTypeT;
+
+typedef struct {
+    const int8_t* key;
+    JSONColumnTypeT type;
+} JSONColumnSpecT;
+
+/**
+ * @struct JSONColumnT
+ * @var values DArrayU32T, DArrayI32T, DArrayT of double, DArrayU8T or string array depending on type.
+ *             Null rows hold 0 (NULL for strings) so the column stays row aligned.
+ * @var nullBitmap One bit per row, set when the row is null.
+ */
+typedef struct {
+    CStringViewT key;
+    JSONColumnTypeT type;
+    DArrayT* values;
+    DArrayU8T* nullBitmap;
+    size_t nullCount;
+} JSONColumnT;
+
+typedef struct {
+    size_t rowCount;
+    size_t columnCount;
+    JSONColumnT* columns;
+} JSONColumnarTableT;
+
+/**
+ * @struct JSONColumnValueT
+ * @brief A scalar as a column sees it, string data points into the source and is copied on push.
+ *        Objects and arrays are NODE_TYPE_NONE and always null.
+ */
+typedef struct {
+    ValueTypeT valueType;
+    double number;
+    const int8_t* data;
+    size_t length;
+} JSONColumnValueT;
+
+/***********************************************************************************************************************
+Static function declarations
+***********************************************************************************************************************/
+
+/**
+ * @brief Extracts the spec columns from an already parsed array of objects.
+ *        On error the table is already destroyed, calling json_columnar_destroy on it again is harmless.
+ */
+static JSONParserResultT json_columnar_from_array(JSONArrayT* array, const JSONColumnSpecT* spec, size_t columnCount,
+                                                  JSONColumnarTableT* table);
+
+/**
+ * @brief Extracts the spec columns straight from JSON text without building the document tree.
+ *        Reads stay within length, truncated or malformed input returns JSON_PARSE_RESULT_ERROR.
+ *        On error the table is already destroyed, calling json_columnar_destroy on it again is harmless.
+ */
+static JSONParserResultT json_columnar_parse_buffer(const int8_t* buffer, size_t length, const JSONColumnSpecT* spec,
+                                                    size_t columnCount, JSONColumnarTableT* table);
+static void json_columnar_destroy(JSONColumnarTableT* table);
+static BOOL json_column_is_null(JSONColumnT* column, size_t row);
+
+static void json_columnar_create(JSONColumnarTableT* table, const JSONColumnSpecT* spec, size_t columnCount);
+static JSONParserResultT json_columnar_parse_row(JSONParserT* parser, JSONColumnarTableT* table, BOOL* seen);
+static BOOL json_columnar_scan_string(JSONParserT* parser, CStringViewT* view);
+static BOOL json_columnar_scan_value(JSONParserT* parser, JSONColumnValueT* value);
+static BOOL json_columnar_skip_value(JSONParserT* parser);
+static BOOL json_columnar_scan_number(JSONParserT* parser);
+static BOOL json_columnar_skip_literal(JSONParserT* parser, const char* literal, size_t length);
+static void json_columnar_skip_spaces(JSONParserT* parser);
+static void json_column_push(JSONColumnT* column, JSONObjectT* value, size_t row);
+static void json_column_push_value(JSONColumnT* column, const JSONColumnValueT* value, size_t row);
+static void json_column_push_null_bit(JSONColumnT* column, size_t row, BOOL isNull);
+
+/***********************************************************************************************************************
+Static function definitions
+***********************************************************************************************************************/
+inline static JSONParserResultT json_columnar_from_array(JSONArrayT* array, const JSONColumnSpecT* spec,
+                                                         size_t columnCount, JSONColumnarTableT* table)
+{
+    JSONParserResultT result = JSON_PARSE_RESULT_OK;
+    json_columnar_create(table, spec, columnCount);
+
+    if (NULL == array || !json_is_node_array(array))
+    {
+        json_columnar_destroy(table);
+        result = JSON_PARSE_RESULT_ERROR;
+    }
+    else
+    {
+        // Homogeneous rows share one shape, so each column resolves its slot once and then indexes directly.
+        JSONFieldCacheT* caches = (JSONFieldCacheT*) CMALLOC(columnCount * sizeof(JSONFieldCacheT) + 1);
+        for (size_t c = 0; c < columnCount; c++)
+        {
+            caches[c].key = table->columns[c].key;
+            caches[c].shape = NULL;
+            caches[c].generation = 0;
+            caches[c].slot = JSON_SHAPE_NO_SLOT;
+        }
+
+        size_t rowCount = darr_length(array->data);
+        for (size_t row = 0; row < rowCount; row++)
+        {
+            JSONObjectT* node = (JSONObjectT*) *(long long*) darr_get_ptr(array->data, row);
+            for (size_t c = 0; c < columnCount; c++)
+            {
+                JSONObjectT* value = NULL;
+                if (NULL != node && json_is_node_object(node))
+                {
+                    value = json_object_get_cached((JSONObjectObjectT*) node, &caches[c]);
+                }
+                json_column_push(&table->columns[c], value, row);
+            }
+        }
+        table->rowCount = rowCount;
+        CFREE(caches, columnCount * sizeof(JSONFieldCacheT) + 1);
+    }
+    return result;
+}
+
+inline static JSONParserResultT json_columnar_parse_buffer(const int8_t* buffer, size_t length,
+                                                           const JSONColumnSpecT* spec, size_t columnCount,
+                                                           JSONColumnarTableT* table)
+{
+    JSONParserResultT result = JSON_PARSE_RESULT_OK;
+    JSONParserT parser = {NULL};
+    parser.buffer = buffer;
+    parser.length = length;
+    parser.mark = JSON_STREAM_NO_MARK;
+
+    json_columnar_create(table, spec, columnCount);
+    BOOL* seen = (BOOL*) CMALLOC(columnCount * sizeof(BOOL) + 1);
+
+    json_columnar_skip_spaces(&parser);
+    if ('[' != json_columnar_peek(&parser))
+    {
+        LOG_ERROR("Expected array of objects!\n");
+        result = JSON_PARSE_RESULT_ERROR;
+    }
+    else
+    {
+        parser.offset++;
+        json_columnar_skip_spaces(&parser);
+
+        BOOL more = (']' != json_columnar_peek(&parser));
+        while (JSON_PARSE_RESULT_OK == result && more)
+        {
+            result = json_columnar_parse_row(&parser, table, seen);
+
+            json_columnar_skip_spaces(&parser);
+            more = (',' == json_columnar_peek(&parser));
+            if (more)
+            {
+                parser.offset++;
+                json_columnar_skip_spaces(&parser);
+            }
+        }
+        if (JSON_PARSE_RESULT_OK == result && ']' != json_columnar_peek(&parser))
+        {
+            LOG_ERROR("Expected comma or end of array at %zu!\n", parser.offset);
+            result = JSON_PARSE_RESULT_ERROR;
+        }
+    }
+
+    if (JSON_PARSE_RESULT_OK == result)
+    {
+        parser.offset++;
+        json_columnar_skip_spaces(&parser);
+        if (parser.offset != parser.length) { result = JSON_PARSE_RESULT_ERROR; }
+    }
+
+    // A failed row may have filled only some of the columns, so a partial table is never handed out
+    if (JSON_PARSE_RESULT_OK != result) { json_columnar_destroy(table); }
+    CFREE(seen, columnCount * sizeof(BOOL) + 1);
+    return result;
+}
+
+inline static void json_columnar_destroy(JSONColumnarTableT* table)
+{
+    for (size_t c = 0; c < table->columnCount; c++)
+    {
+        JSONColumnT* column = &table->columns[c];
+        if (JSON_COLUMN_TYPE_STRING == column->type) { str_arr_destroy(column->values); }
+        else { darr_destroy(column->values); }
+        darr_destroy(column->nullBitmap);
+    }
+    CFREE(table->columns, table->columnCount * sizeof(JSONColumnT));
+    table->columns = NULL;
+    table->columnCount = 0;
+    table->rowCount = 0;
+}
+
+inline static BOOL json_column_is_null(JSONColumnT* column, size_t row)
+{
+    return (darr_get_u8(column->nullBitmap, row / 8u) >> (row % 8u)) & 1u;
+}
+
+inline static void json_columnar_create(JSONColumnarTableT* table, const JSONColumnSpecT* spec, size_t columnCount)
+{
+    table->rowCount = 0;
+    table->columnCount = columnCount;
+    table->columns = (JSONColumnT*) CMALLOC(columnCount * sizeof(JSONColumnT) + 1);
+
+    for (size_t c = 0; c < columnCount; c++)
+    {
+        JSONColumnT* column = &table->columns[c];
+        column->key.data = spec[c].key;
+        column->key.length = strlen((const char*) spec[c].key);
+        column->type = spec[c].type;
+        column->nullBitmap = darr_create_u8();
+        column->nullCount = 0;
+        switch (column->type)
+        {
+            case JSON_COLUMN_TYPE_U32:
+                column->values = darr_create_u32();
+                break;
+            case JSON_COLUMN_TYPE_I32:
+                column->values = darr_create_i32();
+                break;
+            case JSON_COLUMN_TYPE_DOUBLE:
+                column->values = darr_create_generic(sizeof(double));
+                break;
+            case JSON_COLUMN_TYPE_BOOL:
+                column->values = darr_create_u8();
+                break;
+            case JSON_COLUMN_TYPE_STRING:
+                column->values = str_arr_create();
+                break;
+        }
+    }
+}
+
+inline static JSONParserResultT json_columnar_parse_row(JSONParserT* parser, JSONColumnarTableT* table, BOOL* seen)
+{
+    JSONParserResultT result = JSON_PARSE_RESULT_OK;
+    size_t row = table->rowCount;
+
+    if ('{' != json_columnar_peek(parser))
+    {
+        LOG_ERROR("Expected object in row %zu!\n", row);
+        result = JSON_PARSE_RESULT_ERROR;
+    }
+    else
+    {
+        parser->offset++;
+        for (size_t c = 0; c < table->columnCount; c++) { seen[c] = FALSE; }
+
+        json_columnar_skip_spaces(parser);
+        BOOL more = ('}' != json_columnar_peek(parser));
+        while (JSON_PARSE_RESULT_OK == result && more)
+        {
+            CStringViewT key;
+            JSONColumnT* column = NULL;
+            size_t columnIndex = 0;
+
+            if (!json_columnar_scan_string(parser, &key)) { result = JSON_PARSE_RESULT_ERROR; }
+            else
+            {
+                json_columnar_skip_spaces(parser);
+                if (':' != json_columnar_peek(parser)) { result = JSON_PARSE_RESULT_ERROR; }
+                parser->offset++;
+                json_columnar_skip_spaces(parser);
+            }
+
+            for (size_t c = 0; c < table->columnCount && NULL == column && JSON_PARSE_RESULT_OK == result; c++)
+            {
+                if (!seen[c] && key.length == table->columns[c].key.length &&
+                    0 == memcmp(key.data, table->columns[c].key.data, key.length))
+                {
+                    column = &table->columns[c];
+                    columnIndex = c;
+                }
+            }
+
+            // Only values of selected keys are converted, everything else is stepped over without allocating.
+            if (JSON_PARSE_RESULT_OK == result && NULL != column)
+            {
+                JSONColumnValueT value;
+                if (!json_columnar_scan_value(parser, &value)) { result = JSON_PARSE_RESULT_ERROR; }
+                else
+                {
+                    json_column_push_value(column, &value, row);
+                    seen[columnIndex] = TRUE;
+                }
+            }
+            else if (JSON_PARSE_RESULT_OK == result && !json_columnar_skip_value(parser))
+            {
+                result = JSON_PARSE_RESULT_ERROR;
+            }
+
+            json_columnar_skip_spaces(parser);
+            more = (',' == json_columnar_peek(parser));
+            if (more)
+            {
+                parser->offset++;
+                json_columnar_skip_spaces(parser);
+            }
+        }
+
+        if (JSON_PARSE_RESULT_OK == result && '}' != json_columnar_peek(parser))
+        {
+            LOG_ERROR("Expected comma or end of object in row %zu!\n", row);
+            result = JSON_PARSE_RESULT_ERROR;
+        }
+        if (JSON_PARSE_RESULT_OK == result)
+        {
+            parser->offset++;
+            for (size_t c = 0; c < table->columnCount; c++)
+            {
+                if (!seen[c]) { json_column_push(&table->columns[c], NULL, row); }
+            }
+            table->rowCount++;
+        }
+    }
+    return result;
+}
+
+inline static BOOL json_columnar_scan_string(JSONParserT* parser, CStringViewT* view)
+{
+    BOOL result = FALSE;
+    if ('"' == json_columnar_peek(parser))
+    {
+        parser->offset++;
+        view->data = &parser->buffer[parser->offset];
+        while (parser->offset < parser->length && '"' != parser->buffer[parser->offset])
+        {
+            // The escaped character is stepped over with its backslash, so \" does not end the string
+            parser->offset += ('\\' == parser->buffer[parser->offset]) ? 2u : 1u;
+        }
+        if (parser->offset < parser->length)
+        {
+            view->length = (size_t) (&parser->buffer[parser->offset] - view->data);
+            parser->offset++;
+            result = TRUE;
+        }
+    }
+    return result;
+}
+
+inline static BOOL json_columnar_scan_value(JSONParserT* parser, JSONColumnValueT* value)
+{
+    BOOL result = TRUE;
+    int8_t byte = json_columnar_peek(parser);
+
+    value->valueType = NODE_TYPE_NONE;
+    value->number = 0.0;
+    value->data = NULL;
+    value->length = 0;
+
+    if ('"' == byte)
+    {
+        CStringViewT view;
+        result = json_columnar_scan_string(parser, &view);
+        value->valueType = NODE_TYPE_STRING;
+        value->data = view.data;
+        value->length = view.length;
+    }
+    else if (json_is_number_start(byte))
+    {
+        size_t start = parser->offset;
+        result = json_columnar_scan_number(parser);
+        value->valueType = NODE_TYPE_NUMBER;
+        if (result) { value->number = json_number_from_text(&parser->buffer[start], parser->offset - start); }
+    }
+    else if ('t' == byte)
+    {
+        result = json_columnar_skip_literal(parser, "true", 4);
+        value->valueType = NODE_TYPE_TRUE;
+    }
+    else if ('f' == byte)
+    {
+        result = json_columnar_skip_literal(parser, "false", 5);
+        value->valueType = NODE_TYPE_FALSE;
+    }
+    else if ('n' == byte)
+    {
+        result = json_columnar_skip_literal(parser, "null", 4);
+        value->valueType = NODE_TYPE_NULL;
+    }
+    else { result = json_columnar_skip_value(parser); }
+    return result;
+}
+
+inline static BOOL json_columnar_skip_value(JSONParserT* parser)
+{
+    BOOL result = TRUE;
+    size_t depth = 0;
+
+    // Only nesting is tracked, the skipped value is checked no further than needed to find its end.
+    do
+    {
+        int8_t byte = json_columnar_peek(parser);
+        if (parser->offset >= parser->length) { result = FALSE; }
+        else if ('"' == byte)
+        {
+            CStringViewT view;
+            result = json_columnar_scan_string(parser, &view);
+        }
+        else if ('{' == byte || '[' == byte)
+        {
+            depth++;
+            parser->offset++;
+        }
+        else if ('}' == byte || ']' == byte)
+        {
+            result = (depth > 0);
+            depth--;
+            parser->offset++;
+        }
+        else if (json_is_number_start(byte)) { result = json_columnar_scan_number(parser); }
+        else if ('t' == byte) { result = json_columnar_skip_literal(parser, "true", 4); }
+        else if ('f' == byte) { result = json_columnar_skip_literal(parser, "false", 5); }
+        else if ('n' == byte) { result = json_columnar_skip_literal(parser, "null", 4); }
+        else if (depth > 0 && (',' == byte || ':' == byte || json_is_char_space(byte))) { parser->offset++; }
+        else { result = FALSE; }
+    } while (result && depth > 0);
+
+    return result;
+}
+
+inline static BOOL json_columnar_scan_number(JSONParserT* parser)
+{
+    const int8_t* data = parser->buffer;
+    size_t length = parser->length;
+    size_t offset = parser->offset;
+    BOOL result = TRUE;
+
+    // Same grammar as json_validate_number, -?(0|[1-9][0-9]*)(.[0-9]+)?([eE][+-]?[0-9]+)?
+    if (offset < length && '-' == data[offset]) { offset++; }
+
+    if (offset < length && '0' == data[offset]) { offset++; }
+    else if (offset < length && json_is_char_digit(data[offset]))
+    {
+        while (offset < length && json_is_char_digit(data[offset])) { offset++; }
+    }
+    else { result = FALSE; }
+
+    if (result && offset < length && '.' == data[offset])
+    {
+        offset++;
+        result = (offset < length && json_is_char_digit(data[offset]));
+        while (offset < length && json_is_char_digit(data[offset])) { offset++; }
+    }
+
+    if (result && offset < length && ('e' == data[offset] || 'E' == data[offset]))
+    {
+        offset++;
+        if (offset < length && ('+' == data[offset] || '-' == data[offset])) { offset++; }
+        result = (offset < length && json_is_char_digit(data[offset]));
+        while (offset < length && json_is_char_digit(data[offset])) { offset++; }
+    }
+
+    // The literal must end here, e.g. "01" or "1.2.3" are rejected rather than cut short
+    if (result && offset < length && json_is_number_char(data[offset])) { result = FALSE; }
+
+    parser->offset = offset;
+    return result;
+}
+
+inline static BOOL json_columnar_skip_literal(JSONParserT* parser, const char* literal, size_t length)
+{
+    BOOL result = (parser->length - parser->offset >= length &&
+                   0 == memcmp(&parser->buffer[parser->offset], literal, length));
+    if (result) { parser->offset += length; }
+    return result;
+}
+
+inline static void json_columnar_skip_spaces(JSONParserT* parser)
+{
+    while (json_is_char_space(json_columnar_peek(parser))) { parser->offset++; }
+}
+
+inline static void json_column_push(JSONColumnT* column, JSONObjectT* value, size_t row)
+{
+    JSONColumnValueT scalar = {NODE_TYPE_NONE, 0.0, NULL, 0};
+    if (NULL != value)
+    {
+        scalar.valueType = value->valueType;
+        if (NODE_TYPE_NUMBER == value->valueType) { scalar.number = ((JSONNumberT*) value)->value; }
+        else if (json_is_node_string(value))
+        {
+            scalar.data = ((JSONStringT*) value)->value->data;
+            scalar.length = ((JSONStringT*) value)->value->length;
+        }
+    }
+    json_column_push_value(column, &scalar, row);
+}
+
+inline static void json_column_push_value(JSONColumnT* column, const JSONColumnValueT* value, size_t row)
+{
+    BOOL isNull = TRUE;
+    BOOL isNumber = (NODE_TYPE_NUMBER == value->valueType);
+    double number = value->number;
+
+    switch (column->type)
+    {
+        case JSON_COLUMN_TYPE_U32: {
+            uint32_t u32 = 0;
+            if (isNumber && number >= 0.0 && number <= (double) UINT32_MAX && number == (double) (uint32_t) number)
+            {
+                u32 = (uint32_t) number;
+                isNull = FALSE;
+            }
+            darr_push_u32(column->values, u32);
+            break;
+        }
+        case JSON_COLUMN_TYPE_I32: {
+            int32_t i32 = 0;
+            if (isNumber && number >= (double) INT32_MIN && number <= (double) INT32_MAX &&
+                number == (double) (int32_t) number)
+            {
+                i32 = (int32_t) number;
+                isNull = FALSE;
+            }
+            darr_push_i32(column->values, i32);
+            break;
+        }
+        case JSON_COLUMN_TYPE_DOUBLE:
+            isNull = !isNumber;
+            darr_push_generic(column->values, &number);
+            break;
+        case JSON_COLUMN_TYPE_BOOL: {
+            uint8_t boolean = 0;
+            if (NODE_TYPE_TRUE == value->valueType || NODE_TYPE_FALSE == value->valueType)
+            {
+                boolean = (NODE_TYPE_TRUE == value->valueType);
+                isNull = FALSE;
+            }
+            darr_push_u8(column->values, boolean);
+            break;
+        }
+        case JSON_COLUMN_TYPE_STRING: {
+            DStringT* str = NULL;
+            if (NODE_TYPE_STRING == value->valueType)
+            {
+                str = str_create(value->data, value->length);
+                isNull = FALSE;
+            }
+            darr_push_ptr(column->values, str);
+            break;
+        }
+    }
+    json_column_push_null_bit(column, row, isNull);
+}
+
+inline static void json_column_push_null_bit(JSONColumnT* column, size_t row, BOOL isNull)
+{
+    if (0u == row % 8u) { darr_push_u8(column->nullBitmap, 0); }
+    if (isNull)
+    {
+        *darr_get_u8_ptr(column->nullBitmap, row / 8u) |= (uint8_t) (1u << (row % 8u));
+        column->nullCount++;
+    }
+}
+
+#endif// JSONCOLUMNAR_HEADER
@@ -0,0 +1,508 @@
+#ifndef JSONHASH_HEADER
+#define JSONHASH_HEADER
+/**
+ * @file
+ * @author Krusto Stoyanov ( k.stoianov2@gmail.com )
+ * @brief
+ * @version 1.0
+ * @date
+ *
+ * @section LICENSE
+ * MIT License
+ *
+ * Copyright (c) 2024 Krusto
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Structural hashing, deep equality and diffing of JSON trees.
+ * Hashes are order-insensitive for object members and cached on the nodes,
+ * so trees must not be modified after they were hashed.
+ */
+
+
+/***********************************************************************************************************************
+Includes
+***********************************************************************************************************************/
+#include "JSONParser.h"
+
+
+/***********************************************************************************************************************
+Macro Definitions
+***********************************************************************************************************************/
+#define JSON_HASH_FNV_OFFSET 0xCBF29CE484222325ull
+#define JSON_HASH_FNV_PRIME 0x100000001B3ull
+#define JSON_HASH_COMBINE_PRIME 0x9E3779B97F4A7C15ull
+
+/**
+ * @def JSON_HASH_INDEX_MIN_MEMBERS
+ * @brief Objects with fewer members are matched by scanning, larger ones get a key hash index
+ */
+#define JSON_HASH_INDEX_MIN_MEMBERS 8u
+
+/***********************************************************************************************************************
+Type Definitions
+***********************************************************************************************************************/
+
+/**
+ * @brief Receives the smallest differing pair found by json_diff
+ * @details Object members are reported as NODE_TYPE_OBJECT_ELEMENT nodes so the key is known,
+ *          one side is NULL when a member or array element exists only on the other side.
+ *          Repeated keys are matched by occurrence, the k-th member named key on one side
+ *          pairs with the k-th member named key on the other, the same rule json_equals uses.
+ */
+typedef void (*JSONDiffFnT)(JSONObjectT* left, JSONObjectT* right, void* context);
+
+/**
+ * @struct JSONMemberIndexT
+ * @brief Open addressing table of object members keyed by the cached key hash, built once per compared object
+ */
+typedef struct {
+    JSONObjectObjectT* object;
+    JSONObjectObjectElementT** slots;
+    size_t mask;
+} JSONMemberIndexT;
+
+/***********************************************************************************************************************
+Static function declarations
+***********************************************************************************************************************/
+static uint64_t json_hash(JSONObjectT* node);
+static BOOL json_equals(JSONObjectT* left, JSONObjectT* right);
+static void json_diff(JSONObjectT* left, JSONObjectT* right, JSONDiffFnT callback, void* context);
+
+static uint64_t* json_hash_cache(JSONObjectT* node);
+static uint64_t json_hash_mix(uint64_t value);
+static uint64_t json_hash_bytes(const int8_t* data, size_t length, uint64_t seed);
+static uint64_t json_hash_compute(JSONObjectT* node);
+static BOOL json_equals_object(JSONObjectObjectT* left, JSONObjectObjectT* right);
+static void json_diff_object(JSONObjectObjectT* left, JSONObjectObjectT* right, JSONDiffFnT callback, void* context);
+static void json_diff_element(JSONObjectObjectElementT* left, JSONObjectObjectElementT* right, JSONDiffFnT callback,
+                              void* context);
+static JSONObjectObjectElementT* json_find_element(JSONObjectObjectT* object, JSONStringT* key, size_t occurrence);
+static size_t json_element_occurrence(JSONObjectObjectT* object, JSONObjectObjectElementT* element);
+static void json_member_index_create(JSONObjectObjectT* object, JSONMemberIndexT* index);
+static JSONObjectObjectElementT* json_member_index_find(JSONMemberIndexT* index, JSONStringT* key,
+                                                        size_t occurrence);
+static size_t json_member_index_occurrence(JSONMemberIndexT* index, JSONObjectObjectElementT* element);
+static void json_member_index_destroy(JSONMemberIndexT* index);
+
+/***********************************************************************************************************************
+Static function definitions
+***********************************************************************************************************************/
+inline static uint64_t json_hash(JSONObjectT* node)
+{
+    uint64_t result = 0;
+    if (NULL != node)
+    {
+        uint64_t* cached = json_hash_cache(node);
+        if (NULL == cached) { result = json_hash_compute(node); }
+        else
+        {
+            if (0 == *cached) { *cached = json_hash_compute(node); }
+            result = *cached;
+        }
+    }
+    return result;
+}
+
+inline static BOOL json_equals(JSONObjectT* left, JSONObjectT* right)
+{
+    BOOL result = FALSE;
+    if (left == right) { result = TRUE; }
+    else if (NULL == left || NULL == right || left->valueType != right->valueType) { result = FALSE; }
+    else if (json_hash(left) != json_hash(right)) { result = FALSE; }
+    else
+    {
+        switch (left->valueType)
+        {
+            case NODE_TYPE_STRING: {
+                DStringT* leftStr = ((JSONStringT*) left)->value;
+                DStringT* rightStr = ((JSONStringT*) right)->value;
+                result = (leftStr->length == rightStr->length) &&
+                         (0 == memcmp(leftStr->data, rightStr->data, leftStr->length));
+                break;
+            }
+            case NODE_TYPE_NUMBER:
+                result = (((JSONNumberT*) left)->value == ((JSONNumberT*) right)->value);
+                break;
+            case NODE_TYPE_ARRAY: {
+                DArrayT* leftData = ((JSONArrayT*) left)->data;
+                DArrayT* rightData = ((JSONArrayT*) right)->data;
+                result = (darr_length(leftData) == darr_length(rightData));
+                for (size_t i = 0; i < darr_length(leftData) && result; i++)
+                {
+                    result = json_equals((JSONObjectT*) *(long long*) darr_get_ptr(leftData, i),
+                                         (JSONObjectT*) *(long long*) darr_get_ptr(rightData, i));
+                }
+                break;
+            }
+            case NODE_TYPE_OBJECT:
+                result = json_equals_object((JSONObjectObjectT*) left, (JSONObjectObjectT*) right);
+                break;
+            case NODE_TYPE_OBJECT_ELEMENT: {
+                JSONObjectObjectElementT* leftElement = (JSONObjectObjectElementT*) left;
+                JSONObjectObjectElementT* rightElement = (JSONObjectObjectElementT*) right;
+                result = json_equals((JSONObjectT*) leftElement->key, (JSONObjectT*) rightElement->key) &&
+                         json_equals(leftElement->value, rightElement->value);
+                break;
+            }
+            default:
+                result = TRUE;
+                break;
+        }
+    }
+    return result;
+}
+
+inline static void json_diff(JSONObjectT* left, JSONObjectT* right, JSONDiffFnT callback, void* context)
+{
+    if (json_equals(left, right)) {}
+    else if (NULL == left || NULL == right || left->valueType != right->valueType) { callback(left, right, context); }
+    else if (json_is_node_object(left))
+    {
+        json_diff_object((JSONObjectObjectT*) left, (JSONObjectObjectT*) right, callback, context);
+    }
+    else if (json_is_node_array(left))
+    {
+        DArrayT* leftData = ((JSONArrayT*) left)->data;
+        DArrayT* rightData = ((JSONArrayT*) right)->data;
+        size_t count = darr_length(leftData) > darr_length(rightData) ? darr_length(leftData) : darr_length(rightData);
+        for (size_t i = 0; i < count; i++)
+        {
+            JSONObjectT* leftValue = NULL;
+            JSONObjectT* rightValue = NULL;
+            if (i < darr_length(leftData)) { leftValue = (JSONObjectT*) *(long long*) darr_get_ptr(leftData, i); }
+            if (i < darr_length(rightData)) { rightValue = (JSONObjectT*) *(long long*) darr_get_ptr(rightData, i); }
+            json_diff(leftValue, rightValue, callback, context);
+        }
+    }
+    else { callback(left, right, context); }
+}
+
+inline static uint64_t* json_hash_cache(JSONObjectT* node)
+{
+    uint64_t* result = NULL;
+    switch (node->valueType)
+    {
+        case NODE_TYPE_STRING:
+            result = &((JSONStringT*) node)->hash;
+            break;
+        case NODE_TYPE_NUMBER:
+            result = &((JSONNumberT*) node)->hash;
+            break;
+        case NODE_TYPE_ARRAY:
+            result = &((JSONArrayT*) node)->hash;
+            break;
+        case NODE_TYPE_OBJECT:
+            result = &((JSONObjectObjectT*) node)->hash;
+            break;
+        case NODE_TYPE_OBJECT_ELEMENT:
+            result = &((JSONObjectObjectElementT*) node)->hash;
+            break;
+        default:
+            // Literals have a constant hash and no room to cache it
+            break;
+    }
+    return result;
+}
+
+inline static uint64_t json_hash_mix(uint64_t value)
+{
+    value ^= value >> 30;
+    value *= 0xBF58476D1CE4E5B9ull;
+    value ^= value >> 27;
+    value *= 0x94D049BB133111EBull;
+    value ^= value >> 31;
+    return value;
+}
+
+inline static uint64_t json_hash_bytes(const int8_t* data, size_t length, uint64_t seed)
+{
+    uint64_t result = seed;
+    for (size_t i = 0; i < length; i++)
+    {
+        result ^= (uint8_t) data[i];
+        result *= JSON_HASH_FNV_PRIME;
+    }
+    return result;
+}
+
+inline static uint64_t json_hash_compute(JSONObjectT* node)
+{
+    uint64_t result = json_hash_mix(JSON_HASH_FNV_OFFSET + (uint64_t) node->valueType);
+    switch (node->valueType)
+    {
+        case NODE_TYPE_STRING: {
+            DStringT* str = ((JSONStringT*) node)->value;
+            result = json_hash_bytes(str->data, str->length, result);
+            break;
+        }
+        case NODE_TYPE_NUMBER: {
+            double value = ((JSONNumberT*) node)->value;
+            if (0.0 == value) { value = 0.0; }// -0.0 compares equal to 0.0, so it has to hash equal too
+            result = json_hash_bytes((const int8_t*) &value, sizeof(value), result);
+            break;
+        }
+        case NODE_TYPE_ARRAY: {
+            DArrayT* data = ((JSONArrayT*) node)->data;
+            for (size_t i = 0; i < darr_length(data); i++)
+            {
+                JSONObjectT* value = (JSONObjectT*) *(long long*) darr_get_ptr(data, i);
+                result = result * JSON_HASH_COMBINE_PRIME + json_hash(value);
+            }
+            break;
+        }
+        case NODE_TYPE_OBJECT: {
+            // Members are summed so the hash does not depend on their order.
+            DArrayT* elements = ((JSONObjectObjectT*) node)->elements;
+            uint64_t members = 0;
+            for (size_t i = 0; i < darr_length(elements); i++)
+            {
+                members += json_hash((JSONObjectT*) *(long long*) darr_get_ptr(elements, i));
+            }
+            result = result * JSON_HASH_COMBINE_PRIME + members;
+            break;
+        }
+        case NODE_TYPE_OBJECT_ELEMENT: {
+            JSONObjectObjectElementT* element = (JSONObjectObjectElementT*) node;
+            result = result * JSON_HASH_COMBINE_PRIME + json_hash((JSONObjectT*) element->key);
+            result = result * JSON_HASH_COMBINE_PRIME + json_hash(element->value);
+            break;
+        }
+        default:
+            break;
+    }
+    result = json_hash_mix(result);
+    // 0 marks an empty cache entry
+    if (0 == result) { result = 1; }
+    return result;
+}
+
+inline static BOOL json_equals_object(JSONObjectObjectT* left, JSONObjectObjectT* right)
+{
+    BOOL result = (darr_length(left->elements) == darr_length(right->elements));
+    size_t count = darr_length(left->elements);
+
+    if (result && NULL != left->shape && left->shape == right->shape)
+    {
+        // Same shape means the same keys in the same slots, so only the values are compared
+        for (size_t i = 0; i < count && result; i++)
+        {
+            JSONObjectObjectElementT* leftElement =
+                    (JSONObjectObjectElementT*) *(long long*) darr_get_ptr(left->elements, i);
+            JSONObjectObjectElementT* rightElement =
+                    (JSONObjectObjectElementT*) *(long long*) darr_get_ptr(right->elements, i);
+            result = json_equals(leftElement->value, rightElement->value);
+        }
+    }
+    else if (result)
+    {
+        // Pairing the k-th occurrence of each key keeps the comparison reflexive for repeated keys
+        JSONMemberIndexT leftIndex;
+        JSONMemberIndexT rightIndex;
+        json_member_index_create(left, &leftIndex);
+        json_member_index_create(right, &rightIndex);
+        for (size_t i = 0; i < count && result; i++)
+        {
+            JSONObjectObjectElementT* leftElement =
+                    (JSONObjectObjectElementT*) *(long long*) darr_get_ptr(left->elements, i);
+            size_t occurrence = json_member_index_occurrence(&leftIndex, leftElement);
+            JSONObjectObjectElementT* rightElement = json_member_index_find(&rightIndex, leftElement->key, occurrence);
+            result = (NULL != rightElement) && json_equals(leftElement->value, rightElement->value);
+        }
+        json_member_index_destroy(&rightIndex);
+        json_member_index_destroy(&leftIndex);
+    }
+    return result;
+}
+
+inline static void json_diff_object(JSONObjectObjectT* left, JSONObjectObjectT* right, JSONDiffFnT callback,
+                                    void* context)
+{
+    size_t leftCount = darr_length(left->elements);
+    size_t rightCount = darr_length(right->elements);
+
+    if (NULL != left->shape && left->shape == right->shape)
+    {
+        for (size_t i = 0; i < leftCount; i++)
+        {
+            json_diff_element((JSONObjectObjectElementT*) *(long long*) darr_get_ptr(left->elements, i),
+                              (JSONObjectObjectElementT*) *(long long*) darr_get_ptr(right->elements, i), callback,
+                              context);
+        }
+    }
+    else
+    {
+        JSONMemberIndexT leftIndex;
+        JSONMemberIndexT rightIndex;
+        json_member_index_create(left, &leftIndex);
+        json_member_index_create(right, &rightIndex);
+
+        for (size_t i = 0; i < leftCount; i++)
+        {
+            JSONObjectObjectElementT* leftElement =
+                    (JSONObjectObjectElementT*) *(long long*) darr_get_ptr(left->elements, i);
+            size_t occurrence = json_member_index_occurrence(&leftIndex, leftElement);
+            JSONObjectObjectElementT* rightElement = json_member_index_find(&rightIndex, leftElement->key, occurrence);
+
+            if (NULL == rightElement) { callback((JSONObjectT*) leftElement, NULL, context); }
+            else { json_diff_element(leftElement, rightElement, callback, context); }
+        }
+        for (size_t i = 0; i < rightCount; i++)
+        {
+            JSONObjectObjectElementT* rightElement =
+                    (JSONObjectObjectElementT*) *(long long*) darr_get_ptr(right->elements, i);
+            size_t occurrence = json_member_index_occurrence(&rightIndex, rightElement);
+            if (NULL == json_member_index_find(&leftIndex, rightElement->key, occurrence))
+            {
+                callback(NULL, (JSONObjectT*) rightElement, context);
+            }
+        }
+
+        json_member_index_destroy(&rightIndex);
+        json_member_index_destroy(&leftIndex);
+    }
+}
+
+inline static void json_diff_element(JSONObjectObjectElementT* left, JSONObjectObjectElementT* right,
+                                     JSONDiffFnT callback, void* context)
+{
+    if (json_hash((JSONObjectT*) left) == json_hash((JSONObjectT*) right)) {}
+    else if (NULL != left->value && NULL != right->value && left->value->valueType == right->value->valueType &&
+             (json_is_node_object(left->value) || json_is_node_array(left->value)))
+    {
+        json_diff(left->value, right->value, callback, context);
+    }
+    else { callback((JSONObjectT*) left, (JSONObjectT*) right, context); }
+}
+
+inline static JSONObjectObjectElementT* json_find_element(JSONObjectObjectT* object, JSONStringT* key,
+                                                          size_t occurrence)
+{
+    JSONObjectObjectElementT* result = NULL;
+    uint64_t keyHash = json_hash((JSONObjectT*) key);
+    for (size_t i = 0; i < darr_length(object->elements) && NULL == result; i++)
+    {
+        JSONObjectObjectElementT* element =
+                (JSONObjectObjectElementT*) *(long long*) darr_get_ptr(object->elements, i);
+        if (keyHash == json_hash((JSONObjectT*) element->key) &&
+            json_equals((JSONObjectT*) element->key, (JSONObjectT*) key))
+        {
+            if (0 == occurrence) { result = element; }
+            else { occurrence--; }
+        }
+    }
+    return result;
+}
+
+inline static size_t json_element_occurrence(JSONObjectObjectT* object, JSONObjectObjectElementT* element)
+{
+    size_t result = 0;
+    uint64_t keyHash = json_hash((JSONObjectT*) element->key);
+    for (size_t i = 0; i < darr_length(object->elements); i++)
+    {
+        JSONObjectObjectElementT* other = (JSONObjectObjectElementT*) *(long long*) darr_get_ptr(object->elements, i);
+        if (other == element) { break; }
+        if (keyHash == json_hash((JSONObjectT*) other->key) &&
+            json_equals((JSONObjectT*) other->key, (JSONObjectT*) element->key))
+        {
+            result++;
+        }
+    }
+    return result;
+}
+
+inline static void json_member_index_create(JSONObjectObjectT* object, JSONMemberIndexT* index)
+{
+    size_t count = darr_length(object->elements);
+    index->object = object;
+    index->slots = NULL;
+    index->mask = 0;
+
+    if (count >= JSON_HASH_INDEX_MIN_MEMBERS)
+    {
+        size_t capacity = 1;
+        while (capacity < count * 2u) { capacity <<= 1u; }
+        index->mask = capacity - 1u;
+        index->slots = (JSONObjectObjectElementT**) CCALLOC(capacity, sizeof(JSONObjectObjectElementT*));
+
+        // Members are inserted in order, so repeated keys follow each other in member order along the probe chain.
+        for (size_t i = 0; i < count; i++)
+        {
+            JSONObjectObjectElementT* element =
+                    (JSONObjectObjectElementT*) *(long long*) darr_get_ptr(object->elements, i);
+            size_t slot = json_hash((JSONObjectT*) element->key) & index->mask;
+            while (NULL != index->slots[slot]) { slot = (slot + 1u) & index->mask; }
+            index->slots[slot] = element;
+        }
+    }
+}
+
+inline static JSONObjectObjectElementT* json_member_index_find(JSONMemberIndexT* index, JSONStringT* key,
+                                                               size_t occurrence)
+{
+    JSONObjectObjectElementT* result = NULL;
+    if (NULL == index->slots) { result = json_find_element(index->object, key, occurrence); }
+    else
+    {
+        // Equal keys sit in the same probe chain in member order, so the chain is counted like the scan counts
+        uint64_t keyHash = json_hash((JSONObjectT*) key);
+        for (size_t slot = keyHash & index->mask; NULL != index->slots[slot] && NULL == result;
+             slot = (slot + 1u) & index->mask)
+        {
+            JSONObjectObjectElementT* element = index->slots[slot];
+            if (keyHash == json_hash((JSONObjectT*) element->key) &&
+                json_equals((JSONObjectT*) element->key, (JSONObjectT*) key))
+            {
+                if (0 == occurrence) { result = element; }
+                else { occurrence--; }
+            }
+        }
+    }
+    return result;
+}
+
+inline static size_t json_member_index_occurrence(JSONMemberIndexT* index, JSONObjectObjectElementT* element)
+{
+    size_t result = 0;
+    if (NULL == index->slots) { result = json_element_occurrence(index->object, element); }
+    else
+    {
+        uint64_t keyHash = json_hash((JSONObjectT*) element->key);
+        for (size_t slot = keyHash & index->mask; index->slots[slot] != element; slot = (slot + 1u) & index->mask)
+        {
+            JSONObjectObjectElementT* other = index->slots[slot];
+            if (keyHash == json_hash((JSONObjectT*) other->key) &&
+                json_equals((JSONObjectT*) other->key, (JSONObjectT*) element->key))
+            {
+                result++;
+            }
+        }
+    }
+    return result;
+}
+
+inline static void json_member_index_destroy(JSONMemberIndexT* index)
+{
+    if (NULL != index->slots) { CFREE(index->slots, (index->mask + 1u) * sizeof(JSONObjectObjectElementT*)); }
+    index->slots = NULL;
+}
+
+#endif// JSONHASH_HEADER
@@ -49,7 +49,7 @@ Macro definitions
 ***********************************************************************************************************************/
 #define json_get_current_char(parser) ((parser)->buffer[(parser)->offset])
 #define json_current_unicode_char(parser) utf8_to_unicode(&json_get_current_char(parser))
-#define json_move_to_next_char(parser) ((parser)->offset += utf8_get_char_length(json_get_current_char(parser)))
+#define json_move_to_next_char(parser) json_advance(parser, utf8_get_char_length(json_get_current_char(parser)))
 #define json_move_to_prev_char(parser) ((parser)->offset -= utf8_get_char_length(json_get_current_char(parser)))
 #define json_current_char_length(parser) utf8_get_char_length(json_get_current_char(parser))
 
@@ -58,6 +58,7 @@ Macro definitions
 #define json_is_string_end(parser) json_check_token(parser, UNICODE_TOKEN_QUOTATION_MARK)
 #define json_is_escape_character(parser) json_check_token(parser, UNICODE_TOKEN_BACK_SLASH)
 #define json_is_array_end(parser) json_check_token(parser, UNICODE_TOKEN_RIGHT_SQUARE_BRACKET)
+#define json_is_input_end(parser) ((parser)->offset >= (parser)->length)
 #define json_is_escaped(parser) (json_get_prev_token(parser) == UNICODE_TOKEN_BACK_SLASH)
 #define json_is_node_string(node) (node->valueType == NODE_TYPE_STRING)
 #define json_is_node_literal(node) (node->valueType != NODE_TYPE_STRING)
@@ -66,26 +67,66 @@ Macro definitions
 #define json_is_node_array(node) (node->valueType == NODE_TYPE_ARRAY)
 #define json_is_node_object_element(node) (node->valueType == NODE_TYPE_OBJECT_ELEMENT)
 #define json_is_token_character(unicodeToken) (unicodeToken >= UNICODE_TOKEN_A && unicodeToken <= UNICODE_TOKEN_Z)
+#define json_is_char_digit(byte) ((byte) >= '0' && (byte) <= '9')
+#define json_is_number_start(byte) (json_is_char_digit(byte) || (byte) == '-')
+#define json_is_number_char(byte)                                                                                      \
+    (json_is_char_digit(byte) || (byte) == '-' || (byte) == '+' || (byte) == '.' || (byte) == 'e' || (byte) == 'E')
 #define json_is_char_space(unicodeChar)                                                                                \
     (unicodeChar == UNICODE_TABULATION || unicodeChar == UNICODE_LINE_FEED ||                                          \
      unicodeChar == UNICODE_CARRIAGE_RETURN || unicodeChar == UNICODE_SPACE)
 
+/***********************************************************************************************************************
+Static variables
+***********************************************************************************************************************/
+
+/**
+ * @brief Generation of the last shape tree created, each parser's root shape takes the next one
+ */
+static uint64_t s_JSONShapeGeneration = 0;
+
 /***********************************************************************************************************************
 Static function declarations
 ***********************************************************************************************************************/
 
 static JSONParserResultT json_parse_file(const char* path, JSONParserT* parser);
+static JSONParserResultT json_parse_stream(JSONStreamReadFnT read, void* context, JSONParserT* parser);
+static BOOL json_is_gzip_file(const char* path);
+#ifdef JSON_PARSER_USE_ZLIB
+static JSONParserResultT json_parse_gzip_file(const char* path, JSONParserT* parser);
+static JSONGzipStreamT* json_gzip_stream_open(const char* path);
+static void json_gzip_stream_close(JSONGzipStreamT* stream);
+static void json_gzip_stream_free(JSONGzipStreamT* stream);
+static size_t json_gzip_stream_read(void* context, int8_t* destination, size_t capacity);
+static void* json_gzip_stream_inflate(void* context);
+#endif
 static void json_print_tree(JSONObjectT* node, uint32_t indent);
 static void destroy_json_parser(JSONParserT* parser);
 static JSONObjectT* json_parse_value(JSONParserT* parser);
+static JSONObjectT* json_parse_predicted_value(JSONParserT* parser, JSONShapeT** prediction);
 static JSONObjectT* json_parse_literal(JSONParserT* parser);
 static JSONStringT* json_parse_string(JSONParserT* parser);
-static JSONArrayT* json_parse_array(JSONParserT* parser);
-static JSONObjectObjectElementT* json_parse_object_element(JSONParserT* parser);
-static JSONObjectObjectT* json_parse_object(JSONParserT* parser);
+static JSONNumberT* json_parse_number(JSONParserT* parser);
+static double json_number_from_text(const int8_t* text, size_t length);
+static JSONArrayT* json_parse_array(JSONParserT* parser, JSONShapeT** prediction);
+static JSONObjectObjectElementT* json_parse_object_element(JSONParserT* parser, JSONShapeT** shape,
+                                                           JSONShapeT* predicted);
+static JSONObjectObjectT* json_parse_object(JSONParserT* parser, JSONShapeT** prediction);
+static BOOL json_scan_string_view(JSONParserT* parser, CStringViewT* view);
+
+static JSONShapeT* json_shape_transition(JSONShapeT* shape, JSONShapeT* predicted, CStringViewT key);
+static JSONShapeT* json_create_shape(JSONShapeT* parent, CStringViewT key);
+static void json_shape_build_path(JSONShapeT* shape);
+static void json_object_own_keys(JSONObjectObjectT* object);
+static void free_shapes(JSONShapeT* shape);
+static size_t json_shape_slot(JSONShapeT* shape, CStringViewT key);
+static JSONObjectT* json_object_get(JSONObjectObjectT* object, const int8_t* key);
+static JSONObjectT* json_object_get_cached(JSONObjectObjectT* object, JSONFieldCacheT* cache);
+static JSONObjectT* json_object_get_slot(JSONObjectObjectT* object, size_t slot);
 
 static JSONTokenT json_get_current_token(JSONParserT* parser);
 static JSONTokenT json_get_prev_token(JSONParserT* parser);
+static void json_advance(JSONParserT* parser, size_t count);
+static void json_stream_refill(JSONParserT* parser);
 static void json_buffer_skip_spaces(JSONParserT* parser);
 static void json_check_skip_colon(JSONParserT* parser);
 static void json_check_skip_comma(JSONParserT* parser);
@@ -94,8 +135,10 @@ static BOOL json_is_literal_true(JSONTokenT* tokens, size_t tokenCount);
 static BOOL json_is_literal_false(JSONTokenT* tokens, size_t tokenCount);
 static BOOL json_is_literal_null(JSONTokenT* tokens, size_t tokenCount);
 static BOOL json_is_unicode_character(UnicodeCharacterT unicodeCharacter);
+static BOOL json_string_equals_view(JSONStringT* str, CStringViewT view);
 
 static JSONStringT* create_node_string(const int8_t* data, size_t length);
+static JSONNumberT* create_node_number(double value);
 static JSONArrayT* create_node_array();
 static JSONObjectObjectElementT* json_create_json_object_element(JSONStringT* key, JSONObjectT* value);
 static JSONObjectObjectT* json_create_json_object();
@@ -113,24 +156,225 @@ inline static JSONParserResultT json_parse_file(const char* path, JSONParserT* p
     JSONParserResultT result = JSON_PARSE_RESULT_ERROR;
     LOG_INFO("Parsing %s\n", path);
 
-    int8_t* data;
-    size_t filesize;
-    FileOpResultT fileReadResult = file_read_utf8(path, &filesize, &data);
-
-    if (FILE_READ_SUCCESFULLY != fileReadResult) { result = JSON_PARSE_RESULT_ERROR; }
+    if (json_is_gzip_file(path))
+    {
+#ifdef JSON_PARSER_USE_ZLIB
+        result = json_parse_gzip_file(path, parser);
+#else
+        LOG_ERROR("%s is gzip compressed but JSONParser was built without zlib!\n", path);
+#endif
+    }
     else
     {
-        parser->buffer = data;
-        parser->length = filesize;
-        parser->offset = 0;
+        int8_t* data;
+        size_t filesize;
+        FileOpResultT fileReadResult = file_read_utf8(path, &filesize, &data);
 
-        parser->root = json_parse_value(parser);
-        if (parser->verboseOutput) { json_print_tree(parser->root, 0); }
-        if (parser->root) { result = JSON_PARSE_RESULT_OK; }
+        if (FILE_READ_SUCCESFULLY != fileReadResult) { result = JSON_PARSE_RESULT_ERROR; }
+        else
+        {
+            parser->buffer = data;
+            parser->length = filesize;
+            parser->offset = 0;
+            parser->streamRead = NULL;
+            parser->mark = JSON_STREAM_NO_MARK;
+
+            parser->root = json_parse_value(parser);
+            if (parser->verboseOutput) { json_print_tree(parser->root, 0); }
+            if (parser->root) { result = JSON_PARSE_RESULT_OK; }
+        }
     }
     return result;
 }
 
+inline static JSONParserResultT json_parse_stream(JSONStreamReadFnT read, void* context, JSONParserT* parser)
+{
+    JSONParserResultT result = JSON_PARSE_RESULT_ERROR;
+
+    parser->capacity = JSON_STREAM_WINDOW_SIZE;
+    parser->buffer = (int8_t*) CMALLOC(parser->capacity + JSON_STREAM_LOOKAHEAD);
+    parser->length = 0;
+    parser->offset = 0;
+    parser->mark = JSON_STREAM_NO_MARK;
+    parser->streamRead = read;
+    parser->streamContext = context;
+    parser->streamEnded = FALSE;
+
+    json_stream_refill(parser);
+    parser->root = json_parse_value(parser);
+
+    // The window is kept until destroy_json_parser, the source is not.
+    parser->streamRead = NULL;
+    parser->streamContext = NULL;
+
+    if (parser->verboseOutput) { json_print_tree(parser->root, 0); }
+    if (parser->root) { result = JSON_PARSE_RESULT_OK; }
+    return result;
+}
+
+inline static BOOL json_is_gzip_file(const char* path)
+{
+    BOOL result = FALSE;
+    FILE* file = fopen(path, "rb");
+    if (NULL != file)
+    {
+        uint8_t magic[2] = {0};
+        if (fread(magic, 1, sizeof(magic), file) == sizeof(magic))
+        {
+            result = (magic[0] == JSON_GZIP_MAGIC_BYTE1 && magic[1] == JSON_GZIP_MAGIC_BYTE2);
+        }
+        fclose(file);
+    }
+    return result;
+}
+
+#ifdef JSON_PARSER_USE_ZLIB
+inline static JSONParserResultT json_parse_gzip_file(const char* path, JSONParserT* parser)
+{
+    JSONParserResultT result = JSON_PARSE_RESULT_ERROR;
+    JSONGzipStreamT* stream = json_gzip_stream_open(path);
+    if (NULL != stream)
+    {
+        result = json_parse_stream(json_gzip_stream_read, stream, parser);
+        if (stream->failed)
+        {
+            LOG_ERROR("Error while decompressing %s!\n", path);
+            result = JSON_PARSE_RESULT_ERROR;
+        }
+        json_gzip_stream_close(stream);
+    }
+    return result;
+}
+
+inline static JSONGzipStreamT* json_gzip_stream_open(const char* path)
+{
+    JSONGzipStreamT* stream = NULL;
+    gzFile file = gzopen(path, "rb");
+    if (NULL == file) { LOG_ERROR("Can not open %s!\n", path); }
+    else
+    {
+        stream = (JSONGzipStreamT*) CCALLOC(1, sizeof(JSONGzipStreamT));
+        stream->file = file;
+        gzbuffer(file, JSON_GZIP_CHUNK_SIZE);
+        for (size_t i = 0; i < JSON_GZIP_RING_SIZE; i++)
+        {
+            stream->chunks[i].data = (int8_t*) CMALLOC(JSON_GZIP_CHUNK_SIZE);
+        }
+        pthread_mutex_init(&stream->mutex, NULL);
+        pthread_cond_init(&stream->chunkFilled, NULL);
+        pthread_cond_init(&stream->chunkFreed, NULL);
+        if (0 != pthread_create(&stream->thread, NULL, json_gzip_stream_inflate, stream))
+        {
+            LOG_ERROR("Can not start the inflate thread for %s!\n", path);
+            json_gzip_stream_free(stream);
+            stream = NULL;
+        }
+    }
+    return stream;
+}
+
+inline static void json_gzip_stream_close(JSONGzipStreamT* stream)
+{
+    // The parser may stop before the end of the input, so wake up the inflate thread if it waits for a free chunk.
+    pthread_mutex_lock(&stream->mutex);
+    stream->cancelled = TRUE;
+    pthread_cond_signal(&stream->chunkFreed);
+    pthread_mutex_unlock(&stream->mutex);
+    pthread_join(stream->thread, NULL);
+
+    json_gzip_stream_free(stream);
+}
+
+inline static void json_gzip_stream_free(JSONGzipStreamT* stream)
+{
+    pthread_cond_destroy(&stream->chunkFreed);
+    pthread_cond_destroy(&stream->chunkFilled);
+    pthread_mutex_destroy(&stream->mutex);
+    for (size_t i = 0; i < JSON_GZIP_RING_SIZE; i++) { CFREE(stream->chunks[i].data, JSON_GZIP_CHUNK_SIZE); }
+    gzclose(stream->file);
+    CFREE(stream, sizeof(JSONGzipStreamT));
+}
+
+inline static size_t json_gzip_stream_read(void* context, int8_t* destination, size_t capacity)
+{
+    JSONGzipStreamT* stream = (JSONGzipStreamT*) context;
+    size_t copied = 0;
+
+    pthread_mutex_lock(&stream->mutex);
+    while (copied < capacity)
+    {
+        // Only block while nothing was copied yet, so parsing can continue alongside inflating.
+        while (0 == stream->filledCount && !stream->finished && 0 == copied)
+        {
+            pthread_cond_wait(&stream->chunkFilled, &stream->mutex);
+        }
+        if (0 == stream->filledCount) { break; }
+
+        JSONGzipChunkT* chunk = &stream->chunks[stream->readIndex];
+        pthread_mutex_unlock(&stream->mutex);
+
+        size_t count = chunk->length - chunk->consumed;
+        if (count > capacity - copied) { count = capacity - copied; }
+        CMEMCPY(&destination[copied], &chunk->data[chunk->consumed], count);
+        chunk->consumed += count;
+        copied += count;
+
+        pthread_mutex_lock(&stream->mutex);
+        if (chunk->consumed == chunk->length)
+        {
+            stream->readIndex = (stream->readIndex + 1) % JSON_GZIP_RING_SIZE;
+            stream->filledCount--;
+            pthread_cond_signal(&stream->chunkFreed);
+        }
+    }
+    pthread_mutex_unlock(&stream->mutex);
+
+    return copied;
+}
+
+inline static void* json_gzip_stream_inflate(void* context)
+{
+    JSONGzipStreamT* stream = (JSONGzipStreamT*) context;
+    BOOL running = TRUE;
+
+    while (running)
+    {
+        pthread_mutex_lock(&stream->mutex);
+        while (JSON_GZIP_RING_SIZE == stream->filledCount && !stream->cancelled)
+        {
+            pthread_cond_wait(&stream->chunkFreed, &stream->mutex);
+        }
+        BOOL cancelled = stream->cancelled;
+        pthread_mutex_unlock(&stream->mutex);
+        if (cancelled) { break; }
+
+        JSONGzipChunkT* chunk = &stream->chunks[stream->writeIndex];
+        int32_t inflated = gzread(stream->file, chunk->data, JSON_GZIP_CHUNK_SIZE);
+
+        pthread_mutex_lock(&stream->mutex);
+        if (inflated > 0)
+        {
+            chunk->length = (size_t) inflated;
+            chunk->consumed = 0;
+            stream->writeIndex = (stream->writeIndex + 1) % JSON_GZIP_RING_SIZE;
+            stream->filledCount++;
+        }
+        else
+        {
+            // A truncated archive ends with 0 bytes read, only gzerror tells it apart from a clean end
+            int error = Z_OK;
+            gzerror(stream->file, &error);
+            stream->finished = TRUE;
+            stream->failed = (inflated < 0 || Z_OK != error);
+            running = FALSE;
+        }
+        pthread_cond_signal(&stream->chunkFilled);
+        pthread_mutex_unlock(&stream->mutex);
+    }
+    return NULL;
+}
+#endif
+
 inline static void json_print_tree(JSONObjectT* node, uint32_t indent)
 {
     switch (node->valueType)
@@ -168,6 +412,9 @@ inline static void json_print_tree(JSONObjectT* node, uint32_t indent)
         case NODE_TYPE_STRING:
             WLOG(L"\"%s\"\n", ((JSONStringT*) node)->value->data);
             break;
+        case NODE_TYPE_NUMBER:
+            WLOG(L"%g\n", ((JSONNumberT*) node)->value);
+            break;
         case NODE_TYPE_TRUE:
             WLOG(L"true\n");
             break;
@@ -185,10 +432,15 @@ inline static void json_print_tree(JSONObjectT* node, uint32_t indent)
 inline static void destroy_json_parser(JSONParserT* parser)
 {
     free_json_tree(parser->root);
+    // Shapes own the object keys, so they go after the tree
+    free_shapes(parser->shapes);
+    parser->shapes = NULL;
     CFREE(parser->buffer, parser->length);
 }
 
-inline static JSONObjectT* json_parse_value(JSONParserT* parser)
+inline static JSONObjectT* json_parse_value(JSONParserT* parser) { return json_parse_predicted_value(parser, NULL); }
+
+inline static JSONObjectT* json_parse_predicted_value(JSONParserT* parser, JSONShapeT** prediction)
 {
     json_buffer_skip_spaces(parser);
     JSONTokenT token = json_get_current_token(parser);
@@ -198,16 +450,20 @@ inline static JSONObjectT* json_parse_value(JSONParserT* parser)
     switch (token)
     {
         case UNICODE_TOKEN_LEFT_CURLY_BRACKET:
-            result = (JSONObjectT*) json_parse_object(parser);
+            result = (JSONObjectT*) json_parse_object(parser, prediction);
             break;
         case UNICODE_TOKEN_LEFT_SQUARE_BRACKET:
-            result = (JSONObjectT*) json_parse_array(parser);
+            result = (JSONObjectT*) json_parse_array(parser, prediction);
             break;
         case UNICODE_TOKEN_QUOTATION_MARK:
             result = (JSONObjectT*) json_parse_string(parser);
             break;
         default:
             if (json_is_token_character(token)) { result = (JSONObjectT*) json_parse_literal(parser); }
+            else if (json_is_number_start(json_get_current_char(parser)))
+            {
+                result = (JSONObjectT*) json_parse_number(parser);
+            }
             break;
     }
     return result;
@@ -250,88 +506,335 @@ inline static JSONStringT* json_parse_string(JSONParserT* parser)
     if (json_is_string_start(parser))
     {
         CStringViewT str;
-        const int8_t* data = &parser->buffer[parser->offset + json_current_char_length(parser)];
+        // The string start is pinned by the mark, a streamed window may move while the string is scanned.
+        parser->mark = parser->offset + json_current_char_length(parser);
         uint32_t length = 0;
-        parser->offset += 1;
+        json_advance(parser, 1);
 
         JSONTokenT token = json_get_current_token(parser);
-        while (!json_is_string_end(parser) || json_is_escape_character(parser))
+        while ((!json_is_string_end(parser) || json_is_escape_character(parser)) && !json_is_input_end(parser))
         {
             if (json_is_escaped(parser) && json_is_string_end(parser)) { token = UNICODE_TOKEN_NONE; }
             length += json_current_char_length(parser);
             json_move_to_next_char(parser);
         }
-        if (json_is_string_end(parser)) { json_move_to_next_char(parser); }
-
-        result = create_node_string(data, length);
+        // An unterminated string means the input was cut off
+        if (!json_is_input_end(parser))
+        {
+            const int8_t* data = &parser->buffer[parser->mark];
+            result = create_node_string(data, length);
+            json_move_to_next_char(parser);
+        }
+        parser->mark = JSON_STREAM_NO_MARK;
     }
 
     return result;
 }
 
-inline static JSONArrayT* json_parse_array(JSONParserT* parser)
+inline static JSONNumberT* json_parse_number(JSONParserT* parser)
+{
+    // Pinned like strings, so long numbers are converted whole even when the window moves.
+    parser->mark = parser->offset;
+    while (json_is_number_char(json_get_current_char(parser))) { json_move_to_next_char(parser); }
+
+    double value = json_number_from_text(&parser->buffer[parser->mark], parser->offset - parser->mark);
+    parser->mark = JSON_STREAM_NO_MARK;
+
+    return create_node_number(value);
+}
+
+inline static double json_number_from_text(const int8_t* text, size_t length)
+{
+    // strtod needs a terminated copy, short numbers are copied to the stack
+    char literal[JSON_NUMBER_MAX_LENGTH + 1];
+    char* copy = (length > JSON_NUMBER_MAX_LENGTH) ? (char*) CMALLOC(length + 1) : literal;
+
+    CMEMCPY(copy, text, length);
+    copy[length] = '\0';
+    double result = strtod(copy, NULL);
+
+    if (copy != literal) { CFREE(copy, length + 1); }
+    return result;
+}
+
+inline static JSONArrayT* json_parse_array(JSONParserT* parser, JSONShapeT** prediction)
 {
     json_move_to_next_char(parser);
 
     JSONArrayT* result = create_node_array();
 
     JSONTokenT token = UNICODE_TOKEN_ALL;
-    while (!json_is_array_end(parser))
+    BOOL failed = FALSE;
+    while (!failed && !json_is_array_end(parser))
     {
         json_buffer_skip_spaces(parser);
-        darr_push_ptr(result->data, json_parse_value(parser));
+        JSONObjectT* value = json_parse_predicted_value(parser, prediction);
+        if (NULL != value) { darr_push_ptr(result->data, value); }
         json_buffer_skip_spaces(parser);
 
         json_check_skip_comma(parser);
+        // A value that can not be parsed or input that ends early fails the array, a corrupt stream would spin here
+        failed = (NULL == value || json_is_input_end(parser));
     }
-    json_move_to_next_char(parser);
+
+    if (failed)
+    {
+        LOG_ERROR("Invalid value or unexpected end of input in array at %zu!\n", parser->offset);
+        free_array(result);
+        result = NULL;
+    }
+    else { json_move_to_next_char(parser); }
 
     return result;
 }
 
-inline static JSONObjectObjectElementT* json_parse_object_element(JSONParserT* parser)
+inline static JSONObjectObjectElementT* json_parse_object_element(JSONParserT* parser, JSONShapeT** shape,
+                                                                  JSONShapeT* predicted)
 {
     JSONObjectObjectElementT* object = NULL;
+    CStringViewT key;
 
     json_buffer_skip_spaces(parser);
 
-    JSONObjectT* key = json_parse_value(parser);
-
-    if (key->valueType == NODE_TYPE_STRING)
+    // The key is matched against the shape in place, only keys never seen at this position get allocated.
+    if (json_scan_string_view(parser, &key))
     {
+        if (NULL != *shape) { *shape = json_shape_transition(*shape, predicted, key); }
+        JSONStringT* keyNode = (NULL != *shape) ? (*shape)->key : create_node_string(key.data, key.length);
+        parser->mark = JSON_STREAM_NO_MARK;
+        json_move_to_next_char(parser);
+
         json_buffer_skip_spaces(parser);
 
         json_check_skip_colon(parser);
 
         json_buffer_skip_spaces(parser);
 
-        object = json_create_json_object_element((JSONStringT*) key, json_parse_value(parser));
+        JSONShapeT** valuePrediction = (NULL != *shape) ? &(*shape)->valueShape : NULL;
+        object = json_create_json_object_element(keyNode, json_parse_predicted_value(parser, valuePrediction));
     }
-    else { free_json_tree((JSONObjectT*) key); }
+    else { LOG_ERROR("Expected key string!\n"); }
 
     return object;
 }
 
-inline static JSONObjectObjectT* json_parse_object(JSONParserT* parser)
+inline static JSONObjectObjectT* json_parse_object(JSONParserT* parser, JSONShapeT** prediction)
 {
     JSONObjectObjectT* result = NULL;
     json_move_to_next_char(parser);
 
-    JSONTokenT token = UNICODE_TOKEN_ALL;
+    if (NULL == parser->shapes)
+    {
+        CStringViewT rootKey = {NULL, 0};
+        parser->shapes = json_create_shape(NULL, rootKey);
+    }
+    if (NULL == prediction) { prediction = &parser->shapes->valueShape; }
+
+    JSONShapeT* shape = parser->shapes;
+    JSONShapeT* predicted = *prediction;
 
     result = json_create_json_object();
+    if (NULL != predicted) { darr_reserve(result->elements, predicted->keyCount); }
 
-    while (!json_is_object_end(parser))
+    json_buffer_skip_spaces(parser);
+    BOOL failed = FALSE;
+    while (!failed && !json_is_object_end(parser))
     {
-        darr_push_ptr(result->elements, json_parse_object_element(parser));
+        BOOL shared = (NULL != shape);
+        JSONObjectObjectElementT* element = json_parse_object_element(parser, &shape, predicted);
+        if (NULL == element) { failed = TRUE; }
+        else
+        {
+            // Past the shape limits the object owns its keys, including the ones parsed so far
+            if (shared && NULL == shape) { json_object_own_keys(result); }
+            darr_push_ptr(result->elements, element);
 
-        json_buffer_skip_spaces(parser);
-        json_check_skip_comma(parser);
+            json_buffer_skip_spaces(parser);
+            json_check_skip_comma(parser);
 
-        json_buffer_skip_spaces(parser);
+            json_buffer_skip_spaces(parser);
+            failed = (NULL == element->value || json_is_input_end(parser));
+        }
     }
-    json_move_to_next_char(parser);
+    result->shape = shape;
 
+    if (failed)
+    {
+        LOG_ERROR("Invalid member or unexpected end of input in object at %zu!\n", parser->offset);
+        free_object(result);
+        result = NULL;
+    }
+    else
+    {
+        json_move_to_next_char(parser);
+        if (NULL != shape)
+        {
+            json_shape_build_path(shape);
+            *prediction = shape;
+        }
+    }
+
+    return result;
+}
+
+inline static BOOL json_scan_string_view(JSONParserT* parser, CStringViewT* view)
+{
+    BOOL result = FALSE;
+    if (json_is_string_start(parser))
+    {
+        json_move_to_next_char(parser);
+        parser->mark = parser->offset;
+
+        while (!json_is_string_end(parser) && parser->offset < parser->length)
+        {
+            if (json_is_escape_character(parser)) { json_move_to_next_char(parser); }
+            json_move_to_next_char(parser);
+        }
+        if (json_is_string_end(parser))
+        {
+            view->data = &parser->buffer[parser->mark];
+            view->length = parser->offset - parser->mark;
+            result = TRUE;
+        }
+    }
+    return result;
+}
+
+inline static JSONShapeT* json_shape_transition(JSONShapeT* shape, JSONShapeT* predicted, CStringViewT key)
+{
+    JSONShapeT* result = NULL;
+    size_t slot = shape->keyCount;
+
+    // Fast path, the object so far follows the predicted shape and the next key matches too
+    if (NULL != predicted && predicted->keyCount > slot && (0 == slot || predicted->path[slot - 1] == shape) &&
+        json_string_equals_view(predicted->path[slot]->key, key))
+    {
+        result = predicted->path[slot];
+    }
+    for (size_t i = 0; i < darr_length(shape->transitions) && NULL == result; i++)
+    {
+        JSONShapeT* child = (JSONShapeT*) *(long long*) darr_get_ptr(shape->transitions, i);
+        if (json_string_equals_view(child->key, key)) { result = child; }
+    }
+    if (NULL == result && slot < JSON_SHAPE_MAX_KEYS && darr_length(shape->transitions) < JSON_SHAPE_MAX_TRANSITIONS)
+    {
+        result = json_create_shape(shape, key);
+    }
+    return result;
+}
+
+inline static JSONShapeT* json_create_shape(JSONShapeT* parent, CStringViewT key)
+{
+    JSONShapeT* result = (JSONShapeT*) CMALLOC(sizeof(JSONShapeT));
+    result->parent = parent;
+    result->transitions = darr_create_generic(sizeof(JSONShapeT*));
+    result->path = NULL;
+    result->valueShape = NULL;
+
+    if (NULL == parent)
+    {
+        result->key = NULL;
+        result->keyCount = 0;
+        result->generation = ++s_JSONShapeGeneration;
+    }
+    else
+    {
+        result->key = create_node_string(key.data, key.length);
+        result->keyCount = parent->keyCount + 1;
+        result->generation = parent->generation;
+        darr_push_ptr(parent->transitions, result);
+    }
+    return result;
+}
+
+inline static void json_shape_build_path(JSONShapeT* shape)
+{
+    if (NULL == shape->path && shape->keyCount > 0)
+    {
+        shape->path = (JSONShapeT**) CMALLOC(shape->keyCount * sizeof(JSONShapeT*));
+        JSONShapeT* ancestor = shape;
+        for (size_t i = shape->keyCount; i > 0; i--)
+        {
+            shape->path[i - 1] = ancestor;
+            ancestor = ancestor->parent;
+        }
+    }
+}
+
+inline static void json_object_own_keys(JSONObjectObjectT* object)
+{
+    for (size_t i = 0; i < darr_length(object->elements); i++)
+    {
+        JSONObjectObjectElementT* element =
+                (JSONObjectObjectElementT*) *(long long*) darr_get_ptr(object->elements, i);
+        element->key = create_node_string(element->key->value->data, element->key->value->length);
+    }
+}
+
+inline static void free_shapes(JSONShapeT* shape)
+{
+    if (NULL != shape)
+    {
+        for (size_t i = 0; i < darr_length(shape->transitions); i++)
+        {
+            free_shapes((JSONShapeT*) *(long long*) darr_get_ptr(shape->transitions, i));
+        }
+        darr_destroy(shape->transitions);
+        if (NULL != shape->key) { free_string(shape->key); }
+        if (NULL != shape->path) { CFREE(shape->path, shape->keyCount * sizeof(JSONShapeT*)); }
+        CFREE(shape, sizeof(JSONShapeT));
+    }
+}
+
+inline static size_t json_shape_slot(JSONShapeT* shape, CStringViewT key)
+{
+    size_t result = JSON_SHAPE_NO_SLOT;
+    for (size_t i = 0; i < shape->keyCount && JSON_SHAPE_NO_SLOT == result; i++)
+    {
+        if (json_string_equals_view(shape->path[i]->key, key)) { result = i; }
+    }
+    return result;
+}
+
+inline static JSONObjectT* json_object_get(JSONObjectObjectT* object, const int8_t* key)
+{
+    JSONFieldCacheT cache = {{key, strlen((const char*) key)}, NULL, 0, JSON_SHAPE_NO_SLOT};
+    return json_object_get_cached(object, &cache);
+}
+
+inline static JSONObjectT* json_object_get_cached(JSONObjectObjectT* object, JSONFieldCacheT* cache)
+{
+    JSONObjectT* result = NULL;
+    if (NULL != object->shape)
+    {
+        // Objects sharing a shape keep the key in the same slot, so the lookup is only done once per shape.
+        if (object->shape != cache->shape || object->shape->generation != cache->generation)
+        {
+            cache->shape = object->shape;
+            cache->generation = object->shape->generation;
+            cache->slot = json_shape_slot(object->shape, cache->key);
+        }
+        result = json_object_get_slot(object, cache->slot);
+    }
+    else
+    {
+        for (size_t i = 0; i < darr_length(object->elements) && NULL == result; i++)
+        {
+            JSONObjectObjectElementT* element =
+                    (JSONObjectObjectElementT*) *(long long*) darr_get_ptr(object->elements, i);
+            if (json_string_equals_view(element->key, cache->key)) { result = element->value; }
+        }
+    }
+    return result;
+}
+
+inline static JSONObjectT* json_object_get_slot(JSONObjectObjectT* object, size_t slot)
+{
+    JSONObjectT* result = NULL;
+    if (slot < darr_length(object->elements))
+    {
+        result = ((JSONObjectObjectElementT*) *(long long*) darr_get_ptr(object->elements, slot))->value;
+    }
     return result;
 }
 
@@ -371,6 +874,46 @@ inline static JSONTokenT json_get_prev_token(JSONParserT* parser)
     return result;
 }
 
+inline static void json_advance(JSONParserT* parser, size_t count)
+{
+    parser->offset += count;
+    if (parser->offset + JSON_STREAM_LOOKAHEAD > parser->length) { json_stream_refill(parser); }
+}
+
+inline static void json_stream_refill(JSONParserT* parser)
+{
+    if (NULL != parser->streamRead && !parser->streamEnded)
+    {
+        int8_t* window = (int8_t*) parser->buffer;
+
+        // Drop everything behind the parser except a few bytes for json_get_prev_token and the marked range.
+        size_t keep = (parser->offset > JSON_STREAM_LOOKAHEAD) ? (parser->offset - JSON_STREAM_LOOKAHEAD) : 0;
+        if (parser->mark < keep) { keep = parser->mark; }
+        if (keep > 0)
+        {
+            memmove(window, &window[keep], parser->length - keep);
+            parser->length -= keep;
+            parser->offset -= keep;
+            if (JSON_STREAM_NO_MARK != parser->mark) { parser->mark -= keep; }
+        }
+
+        while (!parser->streamEnded && parser->offset + JSON_STREAM_LOOKAHEAD > parser->length)
+        {
+            if (parser->capacity - parser->length < JSON_STREAM_WINDOW_SIZE / 2)
+            {
+                parser->capacity *= 2;
+                window = (int8_t*) CREALLOC(window, parser->capacity + JSON_STREAM_LOOKAHEAD);
+                parser->buffer = window;
+            }
+            size_t count = parser->streamRead(parser->streamContext, &window[parser->length],
+                                              parser->capacity - parser->length);
+            if (0 == count) { parser->streamEnded = TRUE; }
+            parser->length += count;
+        }
+        CMEMSET(&window[parser->length], 0, JSON_STREAM_LOOKAHEAD);
+    }
+}
+
 inline static void json_buffer_skip_spaces(JSONParserT* parser)
 {
     wchar_t currentChar = UNICODE_TABULATION;
@@ -379,19 +922,19 @@ inline static void json_buffer_skip_spaces(JSONParserT* parser)
     {
         currentChar = json_current_unicode_char(parser);
 
-        if (json_is_char_space(currentChar)) { parser->offset += json_current_char_length(parser); }
+        if (json_is_char_space(currentChar)) { json_advance(parser, json_current_char_length(parser)); }
     }
 }
 
 inline static void json_check_skip_colon(JSONParserT* parser)
 {
     if (json_get_current_token(parser) != UNICODE_TOKEN_COLON) { LOG_ERROR("Expected colon after key string!\n"); }
-    else { parser->offset += json_current_char_length(parser); }
+    else { json_advance(parser, json_current_char_length(parser)); }
 }
 
 inline static void json_check_skip_comma(JSONParserT* parser)
 {
-    if (json_check_token(parser, UNICODE_TOKEN_COMMA)) { parser->offset += json_current_char_length(parser); }
+    if (json_check_token(parser, UNICODE_TOKEN_COMMA)) { json_advance(parser, json_current_char_length(parser)); }
 }
 
 inline static BOOL json_is_literal_true(JSONTokenT* tokens, size_t tokenCount)
@@ -448,15 +991,31 @@ inline static BOOL json_is_unicode_character(UnicodeCharacterT unicodeCharacter)
     return result;
 }
 
+inline static BOOL json_string_equals_view(JSONStringT* str, CStringViewT view)
+{
+    DStringT* value = str->value;
+    return (value->length == view.length) && (0 == memcmp(value->data, view.data, view.length));
+}
+
 inline static JSONStringT* create_node_string(const int8_t* data, size_t length)
 {
     DStringT* dStrResult = str_create(data, length);
     JSONStringT* strJSON = (JSONStringT*) CMALLOC(sizeof(JSONStringT));
     strJSON->valueType = NODE_TYPE_STRING;
     strJSON->value = dStrResult;
+    strJSON->hash = 0;
     return strJSON;
 }
 
+inline static JSONNumberT* create_node_number(double value)
+{
+    JSONNumberT* result = (JSONNumberT*) CMALLOC(sizeof(JSONNumberT));
+    result->valueType = NODE_TYPE_NUMBER;
+    result->value = value;
+    result->hash = 0;
+    return result;
+}
+
 inline static JSONArrayT* create_node_array()
 {
     JSONArrayT* result = NULL;
@@ -464,6 +1023,7 @@ inline static JSONArrayT* create_node_array()
     result->valueType = NODE_TYPE_ARRAY;
     result->elementSize = sizeof(JSONObjectT*);
     result->data = darr_create_generic(result->elementSize);
+    result->hash = 0;
     return result;
 }
 
@@ -473,6 +1033,7 @@ inline static JSONObjectObjectElementT* json_create_json_object_element(JSONStri
     object->valueType = NODE_TYPE_OBJECT_ELEMENT;
     object->key = key;
     object->value = value;
+    object->hash = 0;
     return object;
 }
 
@@ -481,6 +1042,8 @@ inline static JSONObjectObjectT* json_create_json_object()
     JSONObjectObjectT* result = (JSONObjectObjectT*) CMALLOC(sizeof(JSONObjectObjectT));
     result->valueType = NODE_TYPE_OBJECT;
     result->elements = darr_create_generic(sizeof(JSONObjectObjectElementT*));
+    result->hash = 0;
+    result->shape = NULL;
     return result;
 }
 
@@ -514,8 +1077,14 @@ inline static void free_object(JSONObjectObjectT* object)
     DArrayT* elements = object->elements;
     for (size_t i = 0; i < darr_length(elements); i++)
     {
-        JSONObjectT* element = (JSONObjectT*) *(long long*) darr_get_ptr(elements, i);
-        free_json_tree(element);
+        JSONObjectObjectElementT* element = (JSONObjectObjectElementT*) *(long long*) darr_get_ptr(elements, i);
+        if (NULL == object->shape) { free_json_tree((JSONObjectT*) element); }
+        else
+        {
+            // The key belongs to the shape
+            free_json_tree(element->value);
+            CFREE(element, sizeof(JSONObjectObjectElementT));
+        }
     }
     darr_destroy(elements);
     CFREE(object, sizeof(JSONObjecT));
@@ -541,6 +1110,14 @@ inline static void free_json_tree(JSONObjectT* node)
             case NODE_TYPE_STRING:
                 free_string((JSONStringT*) node);
                 break;
+            case NODE_TYPE_NUMBER:
+                CFREE(node, sizeof(JSONNumberT));
+                break;
+            case NODE_TYPE_TRUE:
+            case NODE_TYPE_FALSE:
+            case NODE_TYPE_NULL:
+                CFREE(node, sizeof(JSONObjectT));
+                break;
         }
     }
 }
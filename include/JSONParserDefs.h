@@ -39,9 +39,15 @@
 /***********************************************************************************************************************
 Includes
 ***********************************************************************************************************************/
+#include "CStringView.h"
 #include "DString.h"
 #include "STDTypes.h"
 
+#ifdef JSON_PARSER_USE_ZLIB
+#include <pthread.h>
+#include <zlib.h>
+#endif
+
 
 /***********************************************************************************************************************
 Macro Definitions
@@ -60,6 +66,72 @@ Macro Definitions
 #define UNICODE_TOKEN_NULL_STR "UNICODE_TOKEN_NULL"
 #define UNICODE_TOKEN_BACK_SLASH_STR "UNICODE_TOKEN_BACK_SLASH"
 
+/**
+ * @def JSON_STREAM_LOOKAHEAD
+ * @brief Bytes kept readable around the parser offset of a streamed buffer (longest UTF-8 character and padding)
+ */
+#define JSON_STREAM_LOOKAHEAD 8u
+
+/**
+ * @def JSON_NUMBER_MAX_LENGTH
+ * @brief Longest number literal converted on the stack, longer literals are copied to the heap
+ */
+#define JSON_NUMBER_MAX_LENGTH 64u
+
+/**
+ * @def JSON_STREAM_WINDOW_SIZE
+ * @brief Initial size of the sliding window used when parsing from a stream
+ */
+#define JSON_STREAM_WINDOW_SIZE (256u * 1024u)
+
+/**
+ * @def JSON_STREAM_NO_MARK
+ * @brief Value of JSONParserT::mark when no buffer range has to survive a window refill
+ */
+#define JSON_STREAM_NO_MARK ((size_t) -1)
+
+/**
+ * @def JSON_SHAPE_NO_SLOT
+ * @brief Returned by json_shape_slot when the shape has no such key
+ */
+#define JSON_SHAPE_NO_SLOT ((size_t) -1)
+
+/**
+ * @def JSON_SHAPE_MAX_KEYS
+ * @brief Objects with more keys are parsed without a shape, map like objects would otherwise grow the tree per key
+ */
+#define JSON_SHAPE_MAX_KEYS 64u
+
+/**
+ * @def JSON_SHAPE_MAX_TRANSITIONS
+ * @brief A shape with this many children takes no new keys, objects needing one are parsed without a shape
+ */
+#define JSON_SHAPE_MAX_TRANSITIONS 32u
+
+/**
+ * @def JSON_GZIP_MAGIC_BYTE1
+ * @brief First byte of a gzip member header
+ */
+#define JSON_GZIP_MAGIC_BYTE1 0x1F
+
+/**
+ * @def JSON_GZIP_MAGIC_BYTE2
+ * @brief Second byte of a gzip member header
+ */
+#define JSON_GZIP_MAGIC_BYTE2 0x8B
+
+/**
+ * @def JSON_GZIP_CHUNK_SIZE
+ * @brief Size of a single decompression buffer in the gzip ring
+ */
+#define JSON_GZIP_CHUNK_SIZE (64u * 1024u)
+
+/**
+ * @def JSON_GZIP_RING_SIZE
+ * @brief Number of reusable decompression buffers shared by the inflate thread and the parser
+ */
+#define JSON_GZIP_RING_SIZE 4u
+
 /***********************************************************************************************************************
 Static Variables
 ***********************************************************************************************************************/
@@ -176,29 +248,84 @@ typedef struct {
     void* dummy;
 } JSONObjectT;
 
+/**
+ * The hash members cache the structural hash computed by json_hash (0 until first use).
+ */
 typedef struct {
     ValueTypeT valueType;
     DStringT* value;
     void* dummy;
+    uint64_t hash;
 } JSONStringT;
 
+typedef struct {
+    ValueTypeT valueType;
+    double value;
+    void* dummy;
+    uint64_t hash;
+} JSONNumberT;
+
 typedef struct {
     ValueTypeT valueType;
     uint32_t elementSize;
     DArrayT* data;
+    uint64_t hash;
 } JSONArrayT;
 
 typedef struct {
     ValueTypeT valueType;
     JSONStringT* key;
     JSONObjectT* value;
+    uint64_t hash;
 } JSONObjectObjectElementT;
 
+/**
+ * @struct JSONShapeT
+ * @brief Immutable key layout shared by every object with the same keys in the same order
+ * @details Shapes form a transition tree rooted at the empty shape, each child appends one key.
+ *          Key nodes are owned by the shape and shared by all objects using it.
+ * @var path Only built on shapes an object ends on, path[i] is the ancestor with i + 1 keys,
+ *           so path[i]->key is the key of slot i.
+ * @var valueShape Shape of the last object parsed as this member's value, predicts the next one.
+ *                 On the root it is used for objects that are not a member value.
+ * @var generation Shared by every shape of one parser's tree and new for each tree, so a shape at a reused address
+ *                 is not taken for the one a field cache saw.
+ */
+typedef struct JSONShapeT {
+    struct JSONShapeT* parent;
+    JSONStringT* key;
+    size_t keyCount;
+    struct JSONShapeT** path;
+    DArrayT* transitions;
+    struct JSONShapeT* valueShape;
+    uint64_t generation;
+} JSONShapeT;
+
 typedef struct {
     ValueTypeT valueType;
     DArrayT* elements;
+    uint64_t hash;
+    JSONShapeT* shape;
 } JSONObjectObjectT;
 
+/**
+ * @struct JSONFieldCacheT
+ * @brief Inline cache for json_object_get_cached, remembers the slot of key in the last seen shape
+ * @details The shape is matched by address and generation, so the cache stays valid across parsers.
+ */
+typedef struct {
+    CStringViewT key;
+    JSONShapeT* shape;
+    uint64_t generation;
+    size_t slot;
+} JSONFieldCacheT;
+
+/**
+ * @brief Pulls up to capacity bytes of input into destination
+ * @return Number of bytes written, 0 once the stream is exhausted
+ */
+typedef size_t (*JSONStreamReadFnT)(void* context, int8_t* destination, size_t capacity);
+
 typedef struct {
     const int8_t* buffer;
     size_t length;
@@ -207,6 +334,37 @@ typedef struct {
     BOOL verboseOutput;
 
     JSONObjectT* root;
+    JSONShapeT* shapes;
+
+    JSONStreamReadFnT streamRead;
+    void* streamContext;
+    size_t capacity;
+    size_t mark;
+    BOOL streamEnded;
 } JSONParserT;
 
+#ifdef JSON_PARSER_USE_ZLIB
+typedef struct {
+    int8_t* data;
+    size_t length;
+    size_t consumed;
+} JSONGzipChunkT;
+
+typedef struct {
+    gzFile file;
+    JSONGzipChunkT chunks[JSON_GZIP_RING_SIZE];
+    size_t readIndex;
+    size_t writeIndex;
+    size_t filledCount;
+    BOOL finished;
+    BOOL failed;
+    BOOL cancelled;
+
+    pthread_t thread;
+    pthread_mutex_t mutex;
+    pthread_cond_t chunkFilled;
+    pthread_cond_t chunkFreed;
+} JSONGzipStreamT;
+#endif
+
 #endif// JSONPARSER_DEFS_HEADER
\ No newline at end of file
@@ -0,0 +1,740 @@
+#pragma once
+
+/**
+ * @file
+ * @author Krusto Stoyanov ( k.stoianov2@gmail.com )
+ * @brief
+ * @version 1.0
+ * @date
+ *
+ * @section LICENSE
+ * MIT License
+ *
+ * Copyright (c) 2024 Krusto
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Compile time JSON parsing for documents embedded as string literals.
+ * json_parse_static turns the literal into a flat, read-only tape while compiling,
+ * malformed literals fail the build. Strings are views into the literal itself and numbers
+ * round to the same double as strtod.
+ *
+ *     static constexpr auto config = json_parse_static<R"({"port": 8080})">();
+ *     static_assert(json_object_get(config.Root(), "port").Number() == 8080);
+ */
+
+
+/***********************************************************************************************************************
+Includes
+***********************************************************************************************************************/
+#include "JSONParserDefs.h"
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/***********************************************************************************************************************
+Macro Definitions
+***********************************************************************************************************************/
+
+/**
+ * @def JSON_STATIC_MAX_EXACT_MANTISSA
+ * @brief Largest mantissa a double holds exactly
+ */
+#define JSON_STATIC_MAX_EXACT_MANTISSA (uint64_t(1) << 53)
+
+/**
+ * @def JSON_STATIC_MAX_EXACT_POWER
+ * @brief Largest power of ten a double holds exactly
+ */
+#define JSON_STATIC_MAX_EXACT_POWER 22
+
+/**
+ * @def JSON_STATIC_MAX_EXPONENT
+ * @brief Exponent digits stop accumulating here, anything larger is rejected anyway
+ */
+#define JSON_STATIC_MAX_EXPONENT 100000
+
+/**
+ * @def JSON_STATIC_MAX_DIGITS
+ * @brief Significant digits kept for the exact conversion, enough to decide the rounding of any double.
+ *        Later digits only record whether they were all zero.
+ */
+#define JSON_STATIC_MAX_DIGITS 768
+
+/**
+ * @def JSON_STATIC_BIGINT_LIMBS
+ * @brief 32 bit limbs of the exact conversion integers, room for the largest scaled numerator and denominator
+ */
+#define JSON_STATIC_BIGINT_LIMBS 128
+
+/***********************************************************************************************************************
+Compile time errors
+***********************************************************************************************************************/
+
+/**
+ * @brief Deliberately not constexpr, reaching it while parsing at compile time stops the build.
+ *        The compiler shows the call and its message in the error.
+ */
+inline void json_static_parse_error(const char* message) { (void) message; }
+
+/***********************************************************************************************************************
+Types
+***********************************************************************************************************************/
+
+/**
+ * @brief Structural type holding the literal, so it can be passed as a template argument
+ */
+template <size_t N>
+struct JSONStaticLiteral {
+    char data[N];
+
+    constexpr JSONStaticLiteral(const char (&str)[N])
+    {
+        for (size_t i = 0; i < N; i++) { data[i] = str[i]; }
+    }
+
+    constexpr std::string_view View() const { return std::string_view(data, N - 1); }
+};
+
+/**
+ * @brief One tape entry, nodes are stored in document order.
+ * @details Objects are followed by one NODE_TYPE_OBJECT_ELEMENT entry per member holding the key,
+ *          each directly followed by its value. next is the index right after the node's subtree.
+ */
+struct JSONStaticNode {
+    ValueTypeT valueType = NODE_TYPE_NONE;
+    double number = 0.0;
+    std::string_view string;
+    uint32_t count = 0;
+    uint32_t next = 0;
+};
+
+class JSONStaticValue
+{
+public:
+    constexpr JSONStaticValue() = default;
+
+    constexpr JSONStaticValue(const JSONStaticNode* tape, uint32_t index) : m_Tape(tape), m_Index(index) {}
+
+    constexpr bool IsValid() const { return nullptr != m_Tape; }
+
+    constexpr ValueTypeT Type() const { return IsValid() ? Node().valueType : NODE_TYPE_NONE; }
+
+    constexpr double Number() const { return IsValid() ? Node().number : 0.0; }
+
+    constexpr std::string_view String() const { return IsValid() ? Node().string : std::string_view(); }
+
+    constexpr bool Boolean() const { return IsValid() && NODE_TYPE_TRUE == Node().valueType; }
+
+    constexpr size_t Size() const { return IsValid() ? Node().count : 0u; }
+
+    /**
+     * @brief Element of an array or value of the index-th member of an object, invalid when out of range
+     */
+    constexpr JSONStaticValue At(size_t index) const
+    {
+        JSONStaticValue result;
+        if (index < Size())
+        {
+            uint32_t child = m_Index + 1u;
+            for (size_t i = 0; i < index; i++) { child = m_Tape[child].next; }
+            if (NODE_TYPE_OBJECT == Node().valueType) { child++; }
+            result = JSONStaticValue(m_Tape, child);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Key of the index-th member of an object
+     */
+    constexpr std::string_view Key(size_t index) const
+    {
+        std::string_view result;
+        if (NODE_TYPE_OBJECT == Type() && index < Size())
+        {
+            uint32_t child = m_Index + 1u;
+            for (size_t i = 0; i < index; i++) { child = m_Tape[child].next; }
+            result = m_Tape[child].string;
+        }
+        return result;
+    }
+
+    /**
+     * @brief Value of the member named key, invalid when missing or when this is not an object
+     */
+    constexpr JSONStaticValue Get(std::string_view key) const
+    {
+        JSONStaticValue result;
+        if (NODE_TYPE_OBJECT == Type())
+        {
+            uint32_t child = m_Index + 1u;
+            for (size_t i = 0; i < Size() && !result.IsValid(); i++)
+            {
+                if (m_Tape[child].string == key) { result = JSONStaticValue(m_Tape, child + 1u); }
+                child = m_Tape[child].next;
+            }
+        }
+        return result;
+    }
+
+private:
+    constexpr const JSONStaticNode& Node() const { return m_Tape[m_Index]; }
+
+    const JSONStaticNode* m_Tape = nullptr;
+    uint32_t m_Index = 0;
+};
+
+template <size_t N>
+struct JSONStaticDocument {
+    std::array<JSONStaticNode, N> tape;
+
+    constexpr JSONStaticValue Root() const { return JSONStaticValue(tape.data(), 0u); }
+};
+
+/***********************************************************************************************************************
+Number conversion
+***********************************************************************************************************************/
+
+/**
+ * @brief Fixed capacity unsigned integer, only the operations the exact number conversion needs
+ */
+class JSONStaticBigInt
+{
+public:
+    constexpr void MultiplyAdd(uint32_t factor, uint32_t addend)
+    {
+        uint64_t carry = addend;
+        for (size_t i = 0; i < m_Size; i++)
+        {
+            carry += static_cast<uint64_t>(m_Limbs[i]) * factor;
+            m_Limbs[i] = static_cast<uint32_t>(carry);
+            carry >>= 32u;
+        }
+        if (0u != carry) { Push(static_cast<uint32_t>(carry)); }
+    }
+
+    constexpr void MultiplyPowerOfTen(uint32_t power)
+    {
+        for (; power >= 9u; power -= 9u) { MultiplyAdd(1000000000u, 0u); }
+        uint32_t factor = 1u;
+        for (; power > 0u; power--) { factor *= 10u; }
+        MultiplyAdd(factor, 0u);
+    }
+
+    constexpr void ShiftLeft(uint32_t bits)
+    {
+        if (0u != m_Size)
+        {
+            uint32_t limbs = bits / 32u;
+            uint32_t shift = bits % 32u;
+            if (m_Size + limbs + 1u > JSON_STATIC_BIGINT_LIMBS) { json_static_parse_error("Number is too long"); }
+
+            m_Limbs[m_Size + limbs] = 0u;
+            for (size_t i = m_Size; i > 0u; i--)
+            {
+                uint32_t limb = m_Limbs[i - 1u];
+                if (0u != shift) { m_Limbs[i + limbs] |= limb >> (32u - shift); }
+                m_Limbs[i - 1u + limbs] = limb << shift;
+            }
+            for (size_t i = 0; i < limbs; i++) { m_Limbs[i] = 0u; }
+            m_Size += limbs + 1u;
+            Trim();
+        }
+    }
+
+    /**
+     * @brief Subtracts a value that is not larger than this one
+     */
+    constexpr void Subtract(const JSONStaticBigInt& other)
+    {
+        uint64_t borrow = 0u;
+        for (size_t i = 0; i < m_Size; i++)
+        {
+            uint64_t subtrahend = borrow + ((i < other.m_Size) ? other.m_Limbs[i] : 0u);
+            borrow = (m_Limbs[i] < subtrahend) ? 1u : 0u;
+            m_Limbs[i] = static_cast<uint32_t>((uint64_t(1) << 32u) * borrow + m_Limbs[i] - subtrahend);
+        }
+        Trim();
+    }
+
+    constexpr int32_t Compare(const JSONStaticBigInt& other) const
+    {
+        int32_t result = 0;
+        if (m_Size != other.m_Size) { result = (m_Size < other.m_Size) ? -1 : 1; }
+        for (size_t i = m_Size; 0 == result && i > 0u; i--)
+        {
+            uint32_t limb = m_Limbs[i - 1u];
+            uint32_t otherLimb = other.m_Limbs[i - 1u];
+            if (limb != otherLimb) { result = (limb < otherLimb) ? -1 : 1; }
+        }
+        return result;
+    }
+
+    constexpr int32_t BitLength() const
+    {
+        int32_t result = 0;
+        if (0u != m_Size) { result = static_cast<int32_t>(32u * (m_Size - 1u)) + std::bit_width(m_Limbs[m_Size - 1u]); }
+        return result;
+    }
+
+private:
+    constexpr void Push(uint32_t limb)
+    {
+        if (m_Size >= JSON_STATIC_BIGINT_LIMBS) { json_static_parse_error("Number is too long"); }
+        m_Limbs[m_Size++] = limb;
+    }
+
+    constexpr void Trim()
+    {
+        while (m_Size > 0u && 0u == m_Limbs[m_Size - 1u]) { m_Size--; }
+    }
+
+    std::array<uint32_t, JSON_STATIC_BIGINT_LIMBS + 1u> m_Limbs{};
+    size_t m_Size = 0;
+};
+
+/**
+ * @brief Decimal digits and exponent of a number literal, converted to the double nearest to it.
+ * @details Mantissas up to 2^53 with powers of ten up to 1e22 take the exact fast path, one multiply or divide.
+ *          Everything else is divided out with big integers and rounded half to even, as strtod does.
+ */
+class JSONStaticDecimal
+{
+public:
+    /**
+     * @brief Appends a digit, fraction digits move the exponent down
+     */
+    constexpr void AddDigit(uint32_t digit, bool fraction)
+    {
+        if (m_Count < JSON_STATIC_MAX_DIGITS)
+        {
+            // Leading zeros of a fraction are not significant, they only move the exponent
+            if (0u != m_Count || 0u != digit) { m_Digits[m_Count++] = static_cast<uint8_t>(digit); }
+            if (fraction) { m_Exponent--; }
+        }
+        else
+        {
+            m_Truncated = m_Truncated || (0u != digit);
+            if (!fraction) { m_Exponent++; }
+        }
+    }
+
+    constexpr void AddExponent(int32_t exponent) { m_Exponent += exponent; }
+
+    constexpr double ToDouble() const
+    {
+        double result = 0.0;
+        if (0u != m_Count && !ToDoubleFast(result)) { result = ToDoubleExact(); }
+        return result;
+    }
+
+private:
+    constexpr bool ToDoubleFast(double& value) const
+    {
+        // Trailing zeros are held back from the mantissa, they only move the exponent
+        uint32_t count = m_Count;
+        while (count > 0u && 0u == m_Digits[count - 1u]) { count--; }
+        int32_t exponent = m_Exponent + static_cast<int32_t>(m_Count - count);
+
+        uint64_t mantissa = 0u;
+        bool result = !m_Truncated && count <= 16u;
+        for (uint32_t i = 0; result && i < count; i++) { mantissa = mantissa * 10u + m_Digits[i]; }
+        result = result && mantissa <= JSON_STATIC_MAX_EXACT_MANTISSA;
+
+        while (result && exponent > JSON_STATIC_MAX_EXACT_POWER && mantissa <= JSON_STATIC_MAX_EXACT_MANTISSA / 10u)
+        {
+            mantissa *= 10u;
+            exponent--;
+        }
+        result = result && exponent <= JSON_STATIC_MAX_EXACT_POWER && exponent >= -JSON_STATIC_MAX_EXACT_POWER;
+        if (result)
+        {
+            value = static_cast<double>(mantissa);
+            value = (exponent < 0) ? value / s_PowersOfTen[-exponent] : value * s_PowersOfTen[exponent];
+        }
+        return result;
+    }
+
+    constexpr double ToDoubleExact() const
+    {
+        double result = 0.0;
+        int32_t exponent = m_Exponent;
+        // Decimal magnitude, the value lies in [10^(magnitude - 1), 10^magnitude)
+        int32_t magnitude = static_cast<int32_t>(m_Count) + exponent;
+
+        if (magnitude > 310) { json_static_parse_error("Number is out of the range of double"); }
+        else if (magnitude >= -324)
+        {
+            // value = numerator / denominator, dropped digits leave a trailing 1 that keeps the rounding direction
+            JSONStaticBigInt numerator;
+            JSONStaticBigInt denominator;
+            for (uint32_t i = 0; i < m_Count; i++) { numerator.MultiplyAdd(10u, m_Digits[i]); }
+            if (m_Truncated)
+            {
+                numerator.MultiplyAdd(10u, 1u);
+                exponent--;
+            }
+            denominator.MultiplyAdd(0u, 1u);
+            if (exponent >= 0) { numerator.MultiplyPowerOfTen(static_cast<uint32_t>(exponent)); }
+            else { denominator.MultiplyPowerOfTen(static_cast<uint32_t>(-exponent)); }
+
+            // Binary exponent with 2^binaryExponent <= value < 2^(binaryExponent + 1)
+            int32_t binaryExponent = numerator.BitLength() - denominator.BitLength();
+            JSONStaticBigInt scaledNumerator = numerator;
+            JSONStaticBigInt scaledDenominator = denominator;
+            if (binaryExponent >= 0) { scaledDenominator.ShiftLeft(static_cast<uint32_t>(binaryExponent)); }
+            else { scaledNumerator.ShiftLeft(static_cast<uint32_t>(-binaryExponent)); }
+            if (scaledNumerator.Compare(scaledDenominator) < 0) { binaryExponent--; }
+
+            // Subnormals keep the smallest exponent and lose significand bits instead
+            if (binaryExponent < -1022) { binaryExponent = -1022; }
+            int32_t shift = 52 - binaryExponent;
+            if (shift >= 0) { numerator.ShiftLeft(static_cast<uint32_t>(shift)); }
+            else { denominator.ShiftLeft(static_cast<uint32_t>(-shift)); }
+
+            // The quotient has at most 53 bits, the remainder decides the rounding
+            uint64_t significand = 0u;
+            for (int32_t bit = 52; bit >= 0; bit--)
+            {
+                JSONStaticBigInt term = denominator;
+                term.ShiftLeft(static_cast<uint32_t>(bit));
+                if (numerator.Compare(term) >= 0)
+                {
+                    numerator.Subtract(term);
+                    significand |= uint64_t(1) << bit;
+                }
+            }
+            numerator.ShiftLeft(1u);
+            int32_t half = numerator.Compare(denominator);
+            if (half > 0 || (0 == half && 0u != (significand & 1u))) { significand++; }
+            if ((uint64_t(1) << 53u) == significand)
+            {
+                significand >>= 1u;
+                binaryExponent++;
+            }
+
+            if (binaryExponent > 1023) { json_static_parse_error("Number is out of the range of double"); }
+            uint64_t bits = significand;
+            if (significand >= (uint64_t(1) << 52u))
+            {
+                bits = (static_cast<uint64_t>(binaryExponent + 1023) << 52u) | (significand - (uint64_t(1) << 52u));
+            }
+            result = std::bit_cast<double>(bits);
+        }
+        return result;
+    }
+
+    static constexpr double s_PowersOfTen[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                               1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+    std::array<uint8_t, JSON_STATIC_MAX_DIGITS> m_Digits{};
+    uint32_t m_Count = 0;
+    int32_t m_Exponent = 0;
+    bool m_Truncated = false;
+};
+
+/***********************************************************************************************************************
+Parser
+***********************************************************************************************************************/
+
+/**
+ * @brief Strict recursive descent parser run at compile time, once to count the tape and once to fill it.
+ */
+class JSONStaticParser
+{
+public:
+    constexpr JSONStaticParser(std::string_view source, JSONStaticNode* tape) : m_Source(source), m_Tape(tape) {}
+
+    constexpr uint32_t Parse()
+    {
+        SkipSpaces();
+        ParseValue();
+        SkipSpaces();
+        if (m_Offset != m_Source.size()) { json_static_parse_error("Trailing characters after JSON document"); }
+        return m_Count;
+    }
+
+private:
+    constexpr uint32_t Emit(ValueTypeT valueType)
+    {
+        uint32_t index = m_Count++;
+        if (nullptr != m_Tape) { m_Tape[index].valueType = valueType; }
+        return index;
+    }
+
+    constexpr void Finish(uint32_t index, uint32_t count)
+    {
+        if (nullptr != m_Tape)
+        {
+            m_Tape[index].count = count;
+            m_Tape[index].next = m_Count;
+        }
+    }
+
+    constexpr char Peek() const { return (m_Offset < m_Source.size()) ? m_Source[m_Offset] : '\0'; }
+
+    constexpr void Expect(char c, const char* message)
+    {
+        if (Peek() != c) { json_static_parse_error(message); }
+        m_Offset++;
+    }
+
+    constexpr void SkipSpaces()
+    {
+        while (' ' == Peek() || '\n' == Peek() || '\r' == Peek() || '\t' == Peek()) { m_Offset++; }
+    }
+
+    constexpr static bool IsDigit(char c) { return c >= '0' && c <= '9'; }
+
+    constexpr static bool IsHex(char c) { return IsDigit(c) || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F'); }
+
+    constexpr void ParseValue()
+    {
+        switch (Peek())
+        {
+            case '{':
+                ParseObject();
+                break;
+            case '[':
+                ParseArray();
+                break;
+            case '"': {
+                uint32_t index = Emit(NODE_TYPE_STRING);
+                std::string_view str = ParseString();
+                if (nullptr != m_Tape) { m_Tape[index].string = str; }
+                Finish(index, 0u);
+                break;
+            }
+            case 't':
+                ParseLiteral("true", NODE_TYPE_TRUE);
+                break;
+            case 'f':
+                ParseLiteral("false", NODE_TYPE_FALSE);
+                break;
+            case 'n':
+                ParseLiteral("null", NODE_TYPE_NULL);
+                break;
+            default:
+                if ('-' == Peek() || IsDigit(Peek())) { ParseNumber(); }
+                else { json_static_parse_error("Expected JSON value"); }
+                break;
+        }
+    }
+
+    constexpr void ParseObject()
+    {
+        uint32_t index = Emit(NODE_TYPE_OBJECT);
+        uint32_t count = 0;
+        m_Offset++;
+        SkipSpaces();
+        if ('}' != Peek())
+        {
+            bool more = true;
+            while (more)
+            {
+                SkipSpaces();
+                if ('"' != Peek()) { json_static_parse_error("Expected key string"); }
+                uint32_t element = Emit(NODE_TYPE_OBJECT_ELEMENT);
+                std::string_view key = ParseString();
+                if (nullptr != m_Tape) { m_Tape[element].string = key; }
+                SkipSpaces();
+                Expect(':', "Expected colon after key string");
+                SkipSpaces();
+                ParseValue();
+                Finish(element, 1u);
+                count++;
+
+                SkipSpaces();
+                more = (',' == Peek());
+                if (more) { m_Offset++; }
+            }
+        }
+        Expect('}', "Expected comma or end of object");
+        Finish(index, count);
+    }
+
+    constexpr void ParseArray()
+    {
+        uint32_t index = Emit(NODE_TYPE_ARRAY);
+        uint32_t count = 0;
+        m_Offset++;
+        SkipSpaces();
+        if (']' != Peek())
+        {
+            bool more = true;
+            while (more)
+            {
+                SkipSpaces();
+                ParseValue();
+                count++;
+
+                SkipSpaces();
+                more = (',' == Peek());
+                if (more) { m_Offset++; }
+            }
+        }
+        Expect(']', "Expected comma or end of array");
+        Finish(index, count);
+    }
+
+    /**
+     * @brief Returns the raw string body, escape sequences are validated but kept as written like the runtime parser
+     */
+    constexpr std::string_view ParseString()
+    {
+        m_Offset++;
+        size_t start = m_Offset;
+        while ('"' != Peek())
+        {
+            char c = Peek();
+            if (m_Offset >= m_Source.size()) { json_static_parse_error("Unterminated string"); }
+            else if (static_cast<unsigned char>(c) < 0x20u) { json_static_parse_error("Control character in string"); }
+            else if ('\\' == c)
+            {
+                m_Offset++;
+                switch (Peek())
+                {
+                    case '"':
+                    case '\\':
+                    case '/':
+                    case 'b':
+                    case 'f':
+                    case 'n':
+                    case 'r':
+                    case 't':
+                        break;
+                    case 'u':
+                        for (size_t i = 0; i < 4u; i++)
+                        {
+                            m_Offset++;
+                            if (!IsHex(Peek())) { json_static_parse_error("Invalid unicode escape"); }
+                        }
+                        break;
+                    default:
+                        json_static_parse_error("Invalid escape sequence");
+                        break;
+                }
+            }
+            m_Offset++;
+        }
+        std::string_view result = m_Source.substr(start, m_Offset - start);
+        m_Offset++;
+        return result;
+    }
+
+    constexpr void ParseLiteral(std::string_view literal, ValueTypeT valueType)
+    {
+        if (m_Source.substr(m_Offset, literal.size()) != literal) { json_static_parse_error("Invalid literal"); }
+        m_Offset += literal.size();
+        Finish(Emit(valueType), 0u);
+    }
+
+    /**
+     * @brief Converts to the same double strtod gives the runtime parser, numbers beyond the range of double
+     *        fail the build and numbers below it become zero.
+     */
+    constexpr void ParseNumber()
+    {
+        uint32_t index = Emit(NODE_TYPE_NUMBER);
+        double sign = 1.0;
+        JSONStaticDecimal decimal;
+
+        if ('-' == Peek())
+        {
+            sign = -1.0;
+            m_Offset++;
+        }
+
+        if ('0' == Peek()) { m_Offset++; }
+        else if (IsDigit(Peek()))
+        {
+            while (IsDigit(Peek()))
+            {
+                decimal.AddDigit(static_cast<uint32_t>(Peek() - '0'), false);
+                m_Offset++;
+            }
+        }
+        else { json_static_parse_error("Invalid number"); }
+
+        if ('.' == Peek())
+        {
+            m_Offset++;
+            if (!IsDigit(Peek())) { json_static_parse_error("Expected digit after decimal point"); }
+            while (IsDigit(Peek()))
+            {
+                decimal.AddDigit(static_cast<uint32_t>(Peek() - '0'), true);
+                m_Offset++;
+            }
+        }
+
+        if ('e' == Peek() || 'E' == Peek())
+        {
+            int32_t exponentSign = 1;
+            int32_t exponentValue = 0;
+            m_Offset++;
+            if ('+' == Peek() || '-' == Peek())
+            {
+                exponentSign = ('-' == Peek()) ? -1 : 1;
+                m_Offset++;
+            }
+            if (!IsDigit(Peek())) { json_static_parse_error("Expected digit in exponent"); }
+            while (IsDigit(Peek()))
+            {
+                if (exponentValue < JSON_STATIC_MAX_EXPONENT) { exponentValue = exponentValue * 10 + (Peek() - '0'); }
+                m_Offset++;
+            }
+            decimal.AddExponent(exponentSign * exponentValue);
+        }
+
+        if (nullptr != m_Tape) { m_Tape[index].number = sign * decimal.ToDouble(); }
+        Finish(index, 0u);
+    }
+
+    std::string_view m_Source;
+    JSONStaticNode* m_Tape = nullptr;
+    size_t m_Offset = 0;
+    uint32_t m_Count = 0;
+};
+
+/***********************************************************************************************************************
+Functions
+***********************************************************************************************************************/
+
+/**
+ * @brief Parses Source while compiling, the result can be stored in a static constexpr variable
+ */
+template <JSONStaticLiteral Source>
+consteval auto json_parse_static()
+{
+    constexpr uint32_t count = JSONStaticParser(Source.View(), nullptr).Parse();
+    JSONStaticDocument<count> result{};
+    JSONStaticParser(Source.View(), result.tape.data()).Parse();
+    return result;
+}
+
+/**
+ * @brief Same lookups as the runtime json_object_get / json_object_get_slot, for compile time documents
+ */
+constexpr JSONStaticValue json_object_get(JSONStaticValue object, std::string_view key) { return object.Get(key); }
+
+constexpr JSONStaticValue json_object_get_slot(JSONStaticValue object, size_t slot) { return object.At(slot); }
@@ -0,0 +1,417 @@
+#ifndef JSONVALIDATE_HEADER
+#define JSONVALIDATE_HEADER
+/**
+ * @file
+ * @author Krusto Stoyanov ( k.stoianov2@gmail.com )
+ * @brief
+ * @version 1.0
+ * @date
+ *
+ * @section LICENSE
+ * MIT License
+ *
+ * Copyright (c) 2024 Krusto
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Validation-only pass over JSON text following the strict RFC 8259 grammar.
+ * Nothing is allocated and no tree is built, the first error is reported
+ * with its byte offset and kind.
+ */
+
+
+/***********************************************************************************************************************
+Includes
+***********************************************************************************************************************/
+#include "JSONParser.h"
+
+
+/***********************************************************************************************************************
+Macro Definitions
+***********************************************************************************************************************/
+/**
+ * @def JSON_VALIDATE_MAX_DEPTH
+ * @brief Maximum nesting depth of arrays and objects, the container stack is one bit per level
+ */
+#ifndef JSON_VALIDATE_MAX_DEPTH
+#define JSON_VALIDATE_MAX_DEPTH 1024u
+#endif
+
+#define JSON_VALIDATE_WORD_ONES 0x0101010101010101ull
+#define JSON_VALIDATE_WORD_HIGH_BITS 0x8080808080808080ull
+#define json_validate_word_has_zero(word) (((word) - JSON_VALIDATE_WORD_ONES) & ~(word) & JSON_VALIDATE_WORD_HIGH_BITS)
+#define json_validate_word_has_byte(word, byte) json_validate_word_has_zero((word) ^ (JSON_VALIDATE_WORD_ONES * (byte)))
+#define json_validate_word_has_less(word, byte)                                                                       \
+    (((word) - JSON_VALIDATE_WORD_ONES * (byte)) & ~(word) & JSON_VALIDATE_WORD_HIGH_BITS)
+
+#define json_validate_is_space(byte) ((byte) == ' ' || (byte) == '\n' || (byte) == '\r' || (byte) == '\t')
+#define json_validate_is_digit(byte) ((byte) >= '0' && (byte) <= '9')
+#define json_validate_is_hex(byte)                                                                                     \
+    (json_validate_is_digit(byte) || ((byte) >= 'a' && (byte) <= 'f') || ((byte) >= 'A' && (byte) <= 'F'))
+
+/***********************************************************************************************************************
+Type Definitions
+***********************************************************************************************************************/
+typedef enum
+{
+    JSON_VALIDATE_ERROR_NONE = 0,
+    JSON_VALIDATE_ERROR_UNEXPECTED_END,
+    JSON_VALIDATE_ERROR_UNEXPECTED_CHARACTER,
+    JSON_VALIDATE_ERROR_EXPECTED_COMMA,
+    JSON_VALIDATE_ERROR_EXPECTED_COLON,
+    JSON_VALIDATE_ERROR_EXPECTED_KEY,
+    JSON_VALIDATE_ERROR_INVALID_LITERAL,
+    JSON_VALIDATE_ERROR_INVALID_NUMBER,
+    JSON_VALIDATE_ERROR_INVALID_STRING,
+    JSON_VALIDATE_ERROR_INVALID_ESCAPE,
+    JSON_VALIDATE_ERROR_INVALID_UTF8,
+    JSON_VALIDATE_ERROR_TRAILING_CHARACTERS,
+    JSON_VALIDATE_ERROR_DEPTH_EXCEEDED,
+} JSONValidateErrorT;
+
+typedef struct {
+    const uint8_t* data;
+    size_t length;
+    size_t offset;
+    JSONValidateErrorT error;
+} JSONValidatorT;
+
+/***********************************************************************************************************************
+Static function declarations
+***********************************************************************************************************************/
+
+/**
+ * @brief Checks buffer against the strict JSON grammar without building a tree
+ * @param errorOffset Byte offset of the first error, may be NULL
+ * @param errorKind Kind of the first error, may be NULL
+ * @return JSON_PARSE_RESULT_OK for a valid document, JSON_PARSE_RESULT_ERROR otherwise
+ */
+static JSONParserResultT json_validate(const int8_t* buffer, size_t length, size_t* errorOffset,
+                                       JSONValidateErrorT* errorKind);
+
+static void json_validate_fail(JSONValidatorT* validator, JSONValidateErrorT error);
+static void json_validate_skip_spaces(JSONValidatorT* validator);
+static void json_validate_string(JSONValidatorT* validator);
+static void json_validate_utf8(JSONValidatorT* validator);
+static void json_validate_number(JSONValidatorT* validator);
+static void json_validate_literal(JSONValidatorT* validator, const char* literal, size_t literalLength);
+static void json_validate_key(JSONValidatorT* validator);
+
+/***********************************************************************************************************************
+Static function definitions
+***********************************************************************************************************************/
+inline static JSONParserResultT json_validate(const int8_t* buffer, size_t length, size_t* errorOffset,
+                                              JSONValidateErrorT* errorKind)
+{
+    JSONValidatorT validator = {(const uint8_t*) buffer, length, 0, JSON_VALIDATE_ERROR_NONE};
+    // One bit per open container, set for objects
+    uint64_t containers[JSON_VALIDATE_MAX_DEPTH / 64u + 1u] = {0};
+    size_t depth = 0;
+    BOOL expectValue = TRUE;
+
+    json_validate_skip_spaces(&validator);
+    while (JSON_VALIDATE_ERROR_NONE == validator.error)
+    {
+        if (validator.offset >= validator.length)
+        {
+            if (expectValue || depth > 0) { json_validate_fail(&validator, JSON_VALIDATE_ERROR_UNEXPECTED_END); }
+            break;
+        }
+
+        uint8_t byte = validator.data[validator.offset];
+        if (expectValue)
+        {
+            expectValue = FALSE;
+            switch (byte)
+            {
+                case '{':
+                case '[': {
+                    uint8_t closing = ('{' == byte) ? '}' : ']';
+                    if (depth >= JSON_VALIDATE_MAX_DEPTH)
+                    {
+                        json_validate_fail(&validator, JSON_VALIDATE_ERROR_DEPTH_EXCEEDED);
+                    }
+                    else
+                    {
+                        if ('{' == byte) { containers[depth / 64u] |= (1ull << (depth % 64u)); }
+                        else { containers[depth / 64u] &= ~(1ull << (depth % 64u)); }
+                        depth++;
+                        validator.offset++;
+                        json_validate_skip_spaces(&validator);
+
+                        if (validator.offset < validator.length && closing == validator.data[validator.offset])
+                        {
+                            depth--;
+                            validator.offset++;
+                        }
+                        else
+                        {
+                            if ('{' == byte) { json_validate_key(&validator); }
+                            expectValue = TRUE;
+                        }
+                    }
+                    break;
+                }
+                case '"':
+                    json_validate_string(&validator);
+                    break;
+                case 't':
+                    json_validate_literal(&validator, "true", 4u);
+                    break;
+                case 'f':
+                    json_validate_literal(&validator, "false", 5u);
+                    break;
+                case 'n':
+                    json_validate_literal(&validator, "null", 4u);
+                    break;
+                default:
+                    if ('-' == byte || json_validate_is_digit(byte)) { json_validate_number(&validator); }
+                    else { json_validate_fail(&validator, JSON_VALIDATE_ERROR_UNEXPECTED_CHARACTER); }
+                    break;
+            }
+        }
+        else if (0 == depth) { json_validate_fail(&validator, JSON_VALIDATE_ERROR_TRAILING_CHARACTERS); }
+        else
+        {
+            BOOL inObject = (containers[(depth - 1u) / 64u] >> ((depth - 1u) % 64u)) & 1u;
+            if (',' == byte)
+            {
+                validator.offset++;
+                json_validate_skip_spaces(&validator);
+                if (inObject) { json_validate_key(&validator); }
+                expectValue = TRUE;
+            }
+            else if ((inObject && '}' == byte) || (!inObject && ']' == byte))
+            {
+                depth--;
+                validator.offset++;
+            }
+            else { json_validate_fail(&validator, JSON_VALIDATE_ERROR_EXPECTED_COMMA); }
+        }
+        json_validate_skip_spaces(&validator);
+    }
+
+    if (NULL != errorOffset) { *errorOffset = validator.offset; }
+    if (NULL != errorKind) { *errorKind = validator.error; }
+    return (JSON_VALIDATE_ERROR_NONE == validator.error) ? JSON_PARSE_RESULT_OK : JSON_PARSE_RESULT_ERROR;
+}
+
+inline static void json_validate_fail(JSONValidatorT* validator, JSONValidateErrorT error)
+{
+    if (JSON_VALIDATE_ERROR_NONE == validator->error) { validator->error = error; }
+}
+
+inline static void json_validate_skip_spaces(JSONValidatorT* validator)
+{
+    if (JSON_VALIDATE_ERROR_NONE == validator->error)
+    {
+        while (validator->offset < validator->length && json_validate_is_space(validator->data[validator->offset]))
+        {
+            validator->offset++;
+        }
+    }
+}
+
+inline static void json_validate_string(JSONValidatorT* validator)
+{
+    BOOL closed = FALSE;
+    validator->offset++;
+
+    while (!closed && JSON_VALIDATE_ERROR_NONE == validator->error)
+    {
+        // Skip plain ASCII eight bytes at a time, the same word trick cstr_length uses for the terminator.
+        while (validator->offset + sizeof(uint64_t) <= validator->length)
+        {
+            uint64_t word;
+            CMEMCPY(&word, &validator->data[validator->offset], sizeof(word));
+            if (json_validate_word_has_byte(word, '"') || json_validate_word_has_byte(word, '\\') ||
+                json_validate_word_has_less(word, 0x20u) || (word & JSON_VALIDATE_WORD_HIGH_BITS))
+            {
+                break;
+            }
+            validator->offset += sizeof(word);
+        }
+
+        if (validator->offset >= validator->length)
+        {
+            json_validate_fail(validator, JSON_VALIDATE_ERROR_UNEXPECTED_END);
+            break;
+        }
+
+        uint8_t byte = validator->data[validator->offset];
+        if ('"' == byte)
+        {
+            validator->offset++;
+            closed = TRUE;
+        }
+        else if ('\\' == byte)
+        {
+            if (validator->offset + 1u >= validator->length)
+            {
+                validator->offset = validator->length;
+                json_validate_fail(validator, JSON_VALIDATE_ERROR_UNEXPECTED_END);
+                break;
+            }
+            uint8_t escaped = validator->data[validator->offset + 1u];
+            switch (escaped)
+            {
+                case '"':
+                case '\\':
+                case '/':
+                case 'b':
+                case 'f':
+                case 'n':
+                case 'r':
+                case 't':
+                    validator->offset += 2u;
+                    break;
+                case 'u':
+                    validator->offset += 2u;
+                    for (size_t i = 0; i < 4u && JSON_VALIDATE_ERROR_NONE == validator->error; i++)
+                    {
+                        if (validator->offset >= validator->length)
+                        {
+                            json_validate_fail(validator, JSON_VALIDATE_ERROR_UNEXPECTED_END);
+                        }
+                        else if (!json_validate_is_hex(validator->data[validator->offset]))
+                        {
+                            json_validate_fail(validator, JSON_VALIDATE_ERROR_INVALID_ESCAPE);
+                        }
+                        else { validator->offset++; }
+                    }
+                    break;
+                default:
+                    json_validate_fail(validator, JSON_VALIDATE_ERROR_INVALID_ESCAPE);
+                    break;
+            }
+        }
+        else if (byte < 0x20u) { json_validate_fail(validator, JSON_VALIDATE_ERROR_INVALID_STRING); }
+        else if (byte >= 0x80u) { json_validate_utf8(validator); }
+        else { validator->offset++; }
+    }
+}
+
+inline static void json_validate_utf8(JSONValidatorT* validator)
+{
+    const uint8_t* data = &validator->data[validator->offset];
+    size_t available = validator->length - validator->offset;
+    size_t length = 0;
+    uint8_t low = 0x80u;
+    uint8_t high = 0xBFu;
+
+    // Ranges of the second byte follow RFC 3629, rejecting overlong forms, surrogates and code points past U+10FFFF
+    if (data[0] >= 0xC2u && data[0] <= 0xDFu) { length = 2; }
+    else if (data[0] >= 0xE0u && data[0] <= 0xEFu)
+    {
+        length = 3;
+        if (0xE0u == data[0]) { low = 0xA0u; }
+        if (0xEDu == data[0]) { high = 0x9Fu; }
+    }
+    else if (data[0] >= 0xF0u && data[0] <= 0xF4u)
+    {
+        length = 4;
+        if (0xF0u == data[0]) { low = 0x90u; }
+        if (0xF4u == data[0]) { high = 0x8Fu; }
+    }
+
+    BOOL valid = (length > 0 && available >= length && data[1] >= low && data[1] <= high);
+    for (size_t i = 2; i < length && valid; i++) { valid = (data[i] & 0xC0u) == 0x80u; }
+
+    if (valid) { validator->offset += length; }
+    else { json_validate_fail(validator, JSON_VALIDATE_ERROR_INVALID_UTF8); }
+}
+
+inline static void json_validate_number(JSONValidatorT* validator)
+{
+    const uint8_t* data = validator->data;
+    size_t length = validator->length;
+    size_t offset = validator->offset;
+    BOOL valid = TRUE;
+
+    if ('-' == data[offset]) { offset++; }
+
+    if (offset < length && '0' == data[offset]) { offset++; }
+    else if (offset < length && json_validate_is_digit(data[offset]))
+    {
+        while (offset < length && json_validate_is_digit(data[offset])) { offset++; }
+    }
+    else { valid = FALSE; }
+
+    if (valid && offset < length && '.' == data[offset])
+    {
+        offset++;
+        valid = (offset < length && json_validate_is_digit(data[offset]));
+        while (offset < length && json_validate_is_digit(data[offset])) { offset++; }
+    }
+
+    if (valid && offset < length && ('e' == data[offset] || 'E' == data[offset]))
+    {
+        offset++;
+        if (offset < length && ('+' == data[offset] || '-' == data[offset])) { offset++; }
+        valid = (offset < length && json_validate_is_digit(data[offset]));
+        while (offset < length && json_validate_is_digit(data[offset])) { offset++; }
+    }
+
+    // A number must not run straight into another digit, e.g. the "01" case
+    if (valid && offset < length && json_validate_is_digit(data[offset])) { valid = FALSE; }
+
+    validator->offset = offset;
+    if (!valid) { json_validate_fail(validator, JSON_VALIDATE_ERROR_INVALID_NUMBER); }
+}
+
+inline static void json_validate_literal(JSONValidatorT* validator, const char* literal, size_t literalLength)
+{
+    if (validator->length - validator->offset >= literalLength &&
+        0 == memcmp(&validator->data[validator->offset], literal, literalLength))
+    {
+        validator->offset += literalLength;
+    }
+    else { json_validate_fail(validator, JSON_VALIDATE_ERROR_INVALID_LITERAL); }
+}
+
+inline static void json_validate_key(JSONValidatorT* validator)
+{
+    if (validator->offset >= validator->length) { json_validate_fail(validator, JSON_VALIDATE_ERROR_UNEXPECTED_END); }
+    else if ('"' != validator->data[validator->offset])
+    {
+        json_validate_fail(validator, JSON_VALIDATE_ERROR_EXPECTED_KEY);
+    }
+    else
+    {
+        json_validate_string(validator);
+        json_validate_skip_spaces(validator);
+        if (validator->offset >= validator->length)
+        {
+            json_validate_fail(validator, JSON_VALIDATE_ERROR_UNEXPECTED_END);
+        }
+        else if (':' != validator->data[validator->offset])
+        {
+            json_validate_fail(validator, JSON_VALIDATE_ERROR_EXPECTED_COLON);
+        }
+        else
+        {
+            validator->offset++;
+            json_validate_skip_spaces(validator);
+        }
+    }
+}
+
+#endif// JSONVALIDATE_HEADER